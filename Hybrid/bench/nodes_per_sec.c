@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../include/common.h"
+#include "../include/board.h"
+#include "../include/backtracking.h"
+#include "../include/utils.h"
+
+#define BENCH_SECONDS_PER_SPACE 0.5     // Time spent enumerating the leaves of each solution space
+
+double elapsed_seconds(struct timespec start) {
+
+    /*
+        Helper function to get the seconds elapsed since the given time.
+    */
+
+    /*
+        Parameters:
+            - start: the starting time, from CLOCK_MONOTONIC
+    */
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+int main(int argc, char** argv) {
+
+    /*
+        Microbenchmark of the backtracking search: for each input, the leaves of every solution space are enumerated with build_leaf and next_leaf
+        on the unpruned board for BENCH_SECONDS_PER_SPACE seconds per space, without checking them, and the nodes explored per second are printed.
+        The board is not pruned so that the search has work to do, the throughput measures the cost of a node of the current search only:
+        the white counters of the validity check have no switch back to the row and column rescan they replaced.
+        Usage: nodes_per_sec.out <input files in ../test-cases/inputs/>
+    */
+
+    SolverConfig config = read_config(1, argv);
+    int i, space;
+
+    printf("%-20s %14s %12s %10s %16s\n", "input", "nodes", "leaves", "time (s)", "nodes/sec");
+
+    for (i = 1; i < argc; i++) {
+        Board board;
+        int *unknown_index, *unknown_index_length;
+        long long nodes = 0, leaves = 0;
+        double time = 0;
+
+        read_board(&board, argv[i]);
+        compute_unknowns(board, &unknown_index, &unknown_index_length);
+
+        for (space = 0; space < SOLUTION_SPACES; space++) {
+            struct timespec start;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+
+            // A small space is enumerated again until its time is spent, so that the time is not dominated by the setup of the block
+            do {
+                int processes_in_space = 1, leaves_to_skip = 0;
+                BCB block;
+
+                bool leaf_found = init_solution_space(board, &block, space, &unknown_index)
+                    && build_leaf(board, &block, config, &unknown_index, &unknown_index_length, &processes_in_space, &leaves_to_skip);
+
+                while (leaf_found && elapsed_seconds(start) < BENCH_SECONDS_PER_SPACE) {
+                    leaves++;
+                    leaf_found = next_leaf(board, &block, config, &unknown_index, &unknown_index_length, &processes_in_space, &leaves_to_skip);
+                }
+
+                nodes += block.nodes;
+                free_block(&block);
+            } while (elapsed_seconds(start) < BENCH_SECONDS_PER_SPACE);
+
+            time += elapsed_seconds(start);
+        }
+
+        printf("%-20s %14lld %12lld %10.3f %16.0f\n", argv[i], nodes, leaves, time, nodes / time);
+
+        free(unknown_index);
+        free(unknown_index_length);
+    }
+
+    return 0;
+}
@@ -0,0 +1,9 @@
+#ifndef ARTICULATION_H
+#define ARTICULATION_H
+
+#include "common.h"
+
+void find_articulation_points(Board board, bool *articulation);
+int grid_neighbour(Board board, int cell_index, int direction);
+
+#endif
@@ -3,9 +3,29 @@
 
 #include "common.h"
 
-bool build_leaf(Board board, BCB* block, int uk_x, int uk_y, int **unknown_index, int **unknown_index_length, int *total_processes_in_solution_space, int *solutions_to_skip);
-bool next_leaf(Board board, BCB *block, int **unknown_index, int **unknown_index_length, int *total_processes_in_solution_space, int *solutions_to_skip);
-void init_solution_space(Board board, BCB* block, int solution_space_id, int **unknown_index);
+bool build_leaf(Board board, BCB* block, SolverConfig config, int **unknown_index, int **unknown_index_length, int *total_processes_in_solution_space, int *solutions_to_skip);
+bool next_leaf(Board board, BCB *block, SolverConfig config, int **unknown_index, int **unknown_index_length, int *total_processes_in_solution_space, int *solutions_to_skip);
+int select_unknown(Board board, BCB *block, SolverConfig config, int *cursor, int **unknown_index, int **unknown_index_length, CellState *first_state, ScatterType *group_line);
+int select_group_member(Board board, BCB *block, ScatterType *group_line);
+int count_group_members(Board board, BCB *block, int cell_index, ScatterType group_line);
+int next_group_member(Board board, BCB *block, int cell_index, ScatterType group_line);
+int count_unknown_conflicts(Board board, BCB *block, int cell_index);
+int count_unknown_neighbours(Board board, BCB *block, int cell_index);
+bool backtrack(Board board, BCB *block);
+void init_restarts(Board board, BCB *block, unsigned int seed);
+void shuffle_restart_order(Board board, BCB *block);
+void restart_search(Board board, BCB *block);
+bool apply_decision(Board board, BCB *block, Decision *decision, CellState cell_state);
+bool propagate(Board board, BCB *block, int trail_head);
+bool force_cell(Board board, BCB *block, int x, int y, CellState cell_state);
+void assign_cell(Board board, BCB *block, int cell_index, CellState cell_state);
+void undo_trail(Board board, BCB *block, int trail_mark);
+bool init_solution_space(Board board, BCB* block, int solution_space_id, int **unknown_index);
 void compute_unknowns(Board board, int **unknown_index, int **unknown_index_length);
+void set_cell_state(Board board, BCB *block, int x, int y, CellState cell_state);
+void compute_block_state(Board board, BCB *block);
+void compute_black_chains(Board board, BCB *block);
+void copy_block(Board board, BCB *destination, BCB *source);
+void free_block(BCB *block);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+
+#include "common.h"
+
+#define BITS_PER_WORD 64                                                            // Number of cells stored in each word of a bit row
+#define BITS_PER_WORD_LOG2 6                                                        // Shift that converts a column into the index of its word
+#define WORDS_PER_ROW(cols_count) (((cols_count) + BITS_PER_WORD - 1) / BITS_PER_WORD) // Number of words needed to store a row of the board
+
+// Accessors of the cell (x, y) in a sequence of bit rows, macros so that they do not cost a call in the search kernels
+#define BIT_WORD(rows, words_per_row, x, y) ((rows)[(x) * (words_per_row) + ((y) >> BITS_PER_WORD_LOG2)])
+#define BIT_MASK(y) (1ULL << ((y) & (BITS_PER_WORD - 1)))
+#define get_bit(rows, words_per_row, x, y) ((BIT_WORD(rows, words_per_row, x, y) & BIT_MASK(y)) != 0)
+#define set_bit(rows, words_per_row, x, y) (BIT_WORD(rows, words_per_row, x, y) |= BIT_MASK(y))
+#define clear_bit(rows, words_per_row, x, y) (BIT_WORD(rows, words_per_row, x, y) &= ~BIT_MASK(y))
+
+int count_bits(const uint64_t *rows, int words_count);
+int find_first_bit(const uint64_t *rows, int words_count);
+int find_last_bit(const uint64_t *rows, int words_count);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef BLACK_CHAINS_H
+#define BLACK_CHAINS_H
+
+#include "common.h"
+
+void init_black_chains(Board board, BlackChains *chains);
+void reset_black_chains(Board board, BlackChains *chains);
+void copy_black_chains(Board board, BlackChains *destination, BlackChains *source);
+void free_black_chains(BlackChains *chains);
+int find_chain_root(BlackChains *chains, int node);
+int collect_chain_roots(Board board, BlackChains *chains, CellState *solution, int x, int y, int roots[5]);
+bool closes_black_chain(Board board, BlackChains *chains, CellState *solution, int x, int y);
+void add_black_cell(Board board, BlackChains *chains, CellState *solution, int x, int y);
+void remove_black_cell(Board board, BlackChains *chains, int x, int y);
+
+#endif
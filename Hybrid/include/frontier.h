@@ -0,0 +1,31 @@
+#ifndef FRONTIER_H
+#define FRONTIER_H
+
+#include "common.h"
+
+#define FRONTIER_MAX_COLS 128
+#define FRONTIER_NEW_LABEL 0xFF
+
+// Origin of a state, the candidate it was first reached from and the rank of the process that expanded it. A candidate is 2 * state + 0 for white, + 1 for black
+#define FRONTIER_ORIGIN(rank, candidate) (((long long) (rank) << 32) | (candidate))
+#define FRONTIER_ORIGIN_RANK(origin) ((int) ((origin) >> 32))
+#define FRONTIER_ORIGIN_CANDIDATE(origin) ((int) ((origin) & 0xFFFFFFFF))
+#define FRONTIER_CANDIDATE_STATE(candidate) ((candidate) % 2 == 0 ? WHITE : BLACK)
+
+// Process owning a state when the states are split by hash, the high bits so that they do not depend on the slot in the hash table
+#define FRONTIER_OWNER(hash, processes) ((int) (((hash) >> 32) % (processes)))
+
+void init_frontier_sweep(Board board, FrontierSweep *sweep);
+void free_frontier_sweep(FrontierSweep *sweep);
+void prepare_frontier_layer(FrontierSweep *sweep);
+void expand_frontier_states(Board board, FrontierSweep *sweep, int cell_index, int first, int last);
+bool expand_frontier_state(Board board, FrontierSweep *sweep, int cell_index, const uint64_t *state, CellState cell_state, uint64_t *child);
+void canonicalize_frontier_labels(uint8_t *labels, int cols_count);
+uint64_t hash_frontier_state(const uint64_t *state, int words_count);
+bool merge_frontier_state(FrontierSweep *sweep, const uint64_t *state, long long count, long long origin);
+void merge_frontier_candidates(FrontierSweep *sweep, int rank);
+void grow_frontier_layers(FrontierSweep *sweep);
+void finish_frontier_layer(FrontierSweep *sweep);
+void frontier_to_solution(FrontierSweep *sweep, int state_index, CellState *solution);
+
+#endif
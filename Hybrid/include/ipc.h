@@ -5,8 +5,8 @@
 
 #include "common.h"
 
-void block_to_buffer(BCB* block, int **buffer);
-bool buffer_to_block(int *buffer, BCB *block);
+int block_to_buffer(BCB* block, uint64_t **buffer);
+bool buffer_to_block(uint64_t *buffer, BCB *block);
 void receive_message(Message *message, int source, MPI_Request *request, int tag);
 void send_message(int destination, MPI_Request *request, MessageType type, int data1, int data2, bool invalid, int tag);
 void init_requests_and_messages();
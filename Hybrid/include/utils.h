@@ -7,6 +7,10 @@ void write_solution(Board board);
 void print_vector(int *vector, int size);
 void print_block(Board board, char *title, BCB* block);
 void free_memory(int *pointers[]);
+SolverConfig read_config(int argc, char **argv);
+SolverConfig portfolio_config(SolverConfig config, int group);
+int portfolio_groups_count(int members);
+int portfolio_group_size(int members, int group);
 void mpi_share_board(Board* board, int rank);
 
 #endif
\ No newline at end of file
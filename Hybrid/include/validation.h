@@ -4,7 +4,7 @@
 #include "common.h"
 
 bool is_cell_state_valid(Board board, BCB* block, int x, int y, CellState cell_state);
-int dfs_white_cells(Board board, BCB *block, bool* visited, int row, int col);
+int expand_reached_row(Board board, BCB *block, uint64_t *reached, int words_per_row, int row);
 bool check_hitori_conditions(Board board, BCB* block);
 
 #endif
\ No newline at end of file
@@ -3,20 +3,25 @@
 #include <string.h>
 
 #include "../include/backtracking.h"
+#include "../include/occurrences.h"
 #include "../include/validation.h"
+#include "../include/bitboard.h"
+#include "../include/black_chains.h"
+#include "../include/nogoods.h"
+#include "../include/cdcl.h"
 
-bool build_leaf(Board board, BCB* block, int uk_x, int uk_y, int **unknown_index, int **unknown_index_length, int *total_processes_in_solution_space, int *solutions_to_skip) {
+
+bool build_leaf(Board board, BCB* block, SolverConfig config, int **unknown_index, int **unknown_index_length, int *total_processes_in_solution_space, int *solutions_to_skip) {
 
     /*
-        This function is responsible for building the initial leaves of the solution space tree.
+        This function is responsible for building the next leaf of the solution space tree, starting from the decisions already in the block.
     */
     
     /*
         Parameters:
             board: the board to be solved
             block: the BCB to analyze
-            uk_x: index of the unknown row
-            uk_y: index of the unknown column
+            config: the solver configuration, defining the branching heuristic and the value order
             unknown_index: matrix with the indexes of the unknown cells
             unknown_index_length: vector containing the number of unknown cells in each row
             total_processes_in_solution_space: number of processes working in the solution space
@@ -24,86 +29,393 @@ bool build_leaf(Board board, BCB* block, int uk_x, int uk_y, int **unknown_index
     */
 
     /*
-        Increment the indexes uk_x and uk_y. When uk_y is greater than cols, reset it.
+        With the static order, the search resumes right after the unknown of the last decision. 
+        The cursor is the position of the unknown in the unknown_index matrix (uk_x * cols_count + uk_y).
     */
 
-    int i, board_y_index;
-    while (uk_x < board.rows_count && uk_y >= (*unknown_index_length)[uk_x]) {
-        uk_x++;
-        uk_y = 0;
-    }
+    int cursor = block->decisions_count > 0 ? block->decisions[block->decisions_count - 1].cursor + 1 : 0;
+    int cell_index, words_count = CONFLICT_WORDS(board.rows_count * board.cols_count);
+    CellState first_state;
+    ScatterType group_line;
+
+    /*
+        The conflicts are analyzed only when the block explores its leaves alone: with the skipped leaves, the processes sharing the solution space
+        must enumerate the same leaves in the same order, which a backjump over a refuted subtree would break. The configuration can turn it off too.
+    */
+
+    block->learning = config.learning && *total_processes_in_solution_space == 1;
 
     /*
-        If uk_x is greater than the number of rows, the leaf is built.
-        The nuber of solutions to skip is properly decremented.
+        The restarts need the block to explore its leaves alone too. A block without a random order yet draws one, and drops the decisions
+        it may have received, which follow another order.
     */
 
-    if (uk_x == board.rows_count) {
-        if ((*total_processes_in_solution_space) > 1) {
-            (*solutions_to_skip)--;
-            if ((*solutions_to_skip) == -1) 
-                (*solutions_to_skip) = (*total_processes_in_solution_space) - 1;
-            else {
+    if (config.restarts && block->learning && block->cell_order == NULL) {
+        init_restarts(board, block, config.seed);
+        if (block->decisions_count > 0) {
+            restart_search(board, block);
+            cursor = 0;
+        }
+    }
+
+    while (true) {
+
+        /*
+            Once the Luby budget of nodes of the run is spent, the search restarts from the assumed cells with new random orders,
+            keeping the nogoods learned so far.
+        */
+
+        if (block->cell_order != NULL && block->learning && block->restart_nodes >= luby_sequence(block->restarts) * RESTART_NODES) {
+            restart_search(board, block);
+            cursor = 0;
+        }
+
+        /*
+            Select the next cell to branch on. The cells defined by the solution space and the forced ones are already set and skipped.
+        */
+
+        cell_index = select_unknown(board, block, config, &cursor, unknown_index, unknown_index_length, &first_state, &group_line);
+
+        /*
+            If there are no unknown cells left, the leaf is built.
+            The nuber of solutions to skip is properly decremented, a skipped leaf is treated as a dead end.
+        */
+
+        if (cell_index == -1) {
+            if ((*total_processes_in_solution_space) > 1) {
+                (*solutions_to_skip)--;
+                if ((*solutions_to_skip) == -1) 
+                    (*solutions_to_skip) = (*total_processes_in_solution_space) - 1;
+                else {
+                    if (!backtrack(board, block))
+                        return false;
+                    cursor = block->decisions[block->decisions_count - 1].cursor + 1;
+                    continue;
+                }
+            }
+            return true;
+        }
+
+        /*
+            Push a new decision on the cell, trying the selected state first and the other one as the alternative
+        */
+
+        Decision *decision = &block->decisions[block->decisions_count++];
+        decision->cell = cell_index;
+        decision->cursor = cursor;
+        decision->trail_mark = block->trail_size;
+        decision->first_state = first_state;
+        decision->alternative_tried = false;
+        decision->group_line = group_line;
+        set_earlier_levels(board, block->decision_reasons + (block->decisions_count - 1) * words_count, block->decisions_count);
+
+        if (apply_decision(board, block, decision, first_state)) {
+            cursor++;
+            continue;
+        }
+
+        /*
+            With the conflict analysis, the search jumps back to the deepest decision responsible for the conflict, the new one included.
+            When the conflict budget runs out, the search pauses, and the next call to next_leaf resumes it from here.
+        */
+
+        if (block->learning) {
+            if (!backjump(board, block))
+                return false;
+            if (block->conflict_budget > 0 && --block->conflict_budget == 0) {
+                block->paused = true;
                 return false;
             }
+            cursor = block->decisions[block->decisions_count - 1].cursor + 1;
+            continue;
         }
-        return true;
+
+        decision->alternative_tried = true;
+        if (apply_decision(board, block, decision, first_state == WHITE ? BLACK : WHITE)) {
+            cursor++;
+            continue;
+        }
+
+        /*
+            Neither state is valid, or both lead to a conflict, the decision is dropped and the search goes back to the previous one.
+            Each dropped decision spends the conflict budget too, so that the search without the conflict analysis pauses as well.
+        */
+
+        block->decisions_count--;
+        if (!backtrack(board, block))
+            return false;
+        if (block->conflict_budget > 0 && --block->conflict_budget == 0) {
+            block->paused = true;
+            return false;
+        }
+        cursor = block->decisions[block->decisions_count - 1].cursor + 1;
     }
+}
+
+int select_unknown(Board board, BCB *block, SolverConfig config, int *cursor, int **unknown_index, int **unknown_index_length, CellState *first_state, ScatterType *group_line) {
+
+    /*
+        This function is responsible for selecting the next unknown cell to branch on, and the state to try first.
+            - STATIC_ORDER: the first cell still unknown in the unknown_index order, starting from the cursor
+            - MOST_CONSTRAINED: the unknown cell with the most unknown cells of the same value in its row and column,
+              ties are broken by the unknown_index order
+            - DUPLICATE_GROUPS: the next member of the duplicate group being decided, see select_group_member
+        With the restarts, the cells are scanned in the random order of the block instead of the unknown_index order,
+        and the white first order tries the random phase of the cell first.
+        It returns the index of the cell in the board, or -1 if all the cells are known.
+    */
 
-    
     /*
-        Convert the uk_y index to the board_y_index
+        Parameters:
+            board: the board to be solved
+            block: the BCB to analyze
+            config: the solver configuration
+            cursor: position in the unknown_index matrix, or in the random order, where the static scan starts, updated to the position of the selected cell
+            unknown_index: matrix with the indexes of the unknown cells
+            unknown_index_length: vector containing the number of unknown cells in each row
+            first_state: the state to try first on the selected cell
+            group_line: the line of the duplicate group of the selected cell
     */
 
-    board_y_index = (*unknown_index)[uk_x * board.cols_count + uk_y];
+    int uk_x, uk_y, position, cell_index;
+    int best_cell = -1, best_cursor = -1, best_conflicts = -1, conflicts;
 
     /*
-        Get the cell state with the board_y_index
+        The group members are always tried white first, so that the k members of a group and the all-black case give k + 1 branches.
     */
 
-    CellState cell_state = block->solution[uk_x * board.cols_count + board_y_index];
-    
-    bool is_solution_space_unknown = block->solution_space_unknowns[uk_x * board.cols_count + uk_y];
-    if (!is_solution_space_unknown) {
-        if (cell_state == UNKNOWN)
-            cell_state = WHITE;
+    *group_line = ROWS;
+    if (config.branching == DUPLICATE_GROUPS) {
+        *first_state = WHITE;
+        return select_group_member(board, block, group_line);
     }
-    
-    if (cell_state == UNKNOWN){
-        printf("[Build leaf] Cell is unknown\n");
-        exit(-1);
+
+    if (block->cell_order != NULL) {
+        for (position = config.branching == STATIC_ORDER ? *cursor : 0; position < block->order_length; position++) {
+            cell_index = block->cell_order[position];
+            if (block->solution[cell_index] != UNKNOWN) continue;
+
+            if (config.branching == STATIC_ORDER) {
+                best_cell = cell_index;
+                best_cursor = position;
+                break;
+            }
+
+            conflicts = count_unknown_conflicts(board, block, cell_index);
+            if (conflicts > best_conflicts) {
+                best_conflicts = conflicts;
+                best_cell = cell_index;
+                best_cursor = position;
+            }
+        }
+    }
+
+    uk_x = config.branching == STATIC_ORDER ? *cursor / board.cols_count : 0;
+    uk_y = config.branching == STATIC_ORDER ? *cursor % board.cols_count : 0;
+    for (; uk_x < board.rows_count && block->cell_order == NULL; uk_x++, uk_y = 0) {
+        for (; uk_y < (*unknown_index_length)[uk_x]; uk_y++) {
+            cell_index = uk_x * board.cols_count + (*unknown_index)[uk_x * board.cols_count + uk_y];
+            if (block->solution[cell_index] != UNKNOWN) continue;
+
+            if (config.branching == STATIC_ORDER) {
+                best_cell = cell_index;
+                best_cursor = uk_x * board.cols_count + uk_y;
+                break;
+            }
+
+            conflicts = count_unknown_conflicts(board, block, cell_index);
+            if (conflicts > best_conflicts) {
+                best_conflicts = conflicts;
+                best_cell = cell_index;
+                best_cursor = uk_x * board.cols_count + uk_y;
+            }
+        }
+        if (best_cell != -1 && config.branching == STATIC_ORDER) break;
     }
 
+    if (best_cell == -1) return -1;
+    *cursor = best_cursor;
+
     /*
-        Try to set the cell state to white and black, continuing the iteration
+        With the conflict pressure order, black is tried first when whitening the cell would force more cells to black
+        than the unknown neighbours that blackening it would force to white.
     */
 
-    for (i = 0; i < 2; i++) {
-        if (is_cell_state_valid(board, block, uk_x, board_y_index, cell_state)) {
-            block->solution[uk_x * board.cols_count + board_y_index] = cell_state;
-            if (build_leaf(board, block, uk_x, uk_y + 1, unknown_index, unknown_index_length, total_processes_in_solution_space, solutions_to_skip))
-                return true;
-        }
-        if (is_solution_space_unknown){
-            break;
+    *first_state = WHITE;
+    if (config.value_order == CONFLICT_PRESSURE) {
+        if (best_conflicts == -1)
+            best_conflicts = count_unknown_conflicts(board, block, best_cell);
+        if (best_conflicts > count_unknown_neighbours(board, block, best_cell))
+            *first_state = BLACK;
+    } else if (block->cell_order != NULL)
+        *first_state = block->phases[best_cell];
+    return best_cell;
+}
+
+int select_group_member(Board board, BCB *block, ScatterType *group_line) {
+
+    /*
+        This function is responsible for selecting the next cell to branch on with the duplicate groups heuristic.
+        A group is made of the unknown cells with the same value in a row or column, and at most one of them can stay white.
+        Its members are decided one after the other, white first: a white member forces the others to black through the propagation,
+        while a black one moves the search to the next unknown member. The k members of a group are then decided with k + 1 branches,
+        one for each member staying white and one with all of them black, instead of the 2^k combinations of independent decisions.
+        When the last decided cell is white, or its group has no unknown members left, a new group is started from the first unknown cell
+        of the board, in the line (row or column) where the cell has the most unknown duplicates. A cell without duplicates is a group of size 1.
+        It returns the index of the cell in the board, or -1 if all the cells are known.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to analyze
+            group_line: the line of the group of the selected cell, kept by the decision to resume the group after a black member
+    */
+
+    int cell_index;
+
+    if (block->decisions_count > 0) {
+        Decision *decision = &block->decisions[block->decisions_count - 1];
+        if (block->solution[decision->cell] == BLACK) {
+            cell_index = next_group_member(board, block, decision->cell, decision->group_line);
+            if (cell_index != -1) {
+                *group_line = decision->group_line;
+                return cell_index;
+            }
         }
-        cell_state = BLACK;
     }
-    if (!is_solution_space_unknown)
-        block->solution[uk_x * board.cols_count + board_y_index] = UNKNOWN;
-    return false;
+
+    /*
+        Starting the groups in board order keeps the decisions close to each other, so that the conflicts between them are found early.
+        The cells before the first unknown one are all known, so it is also the first member of both its row and column groups.
+        With the restarts, the groups start in the random order of the block, from a member that may have others before it.
+    */
+
+    int position;
+    for (position = 0; position < (block->cell_order != NULL ? block->order_length : board.rows_count * board.cols_count); position++) {
+        cell_index = block->cell_order != NULL ? block->cell_order[position] : position;
+        if (block->solution[cell_index] != UNKNOWN) continue;
+        *group_line = count_group_members(board, block, cell_index, COLS) > count_group_members(board, block, cell_index, ROWS) ? COLS : ROWS;
+        return cell_index;
+    }
+    return -1;
 }
 
-bool next_leaf(Board board, BCB *block, int **unknown_index, int **unknown_index_length, int *total_processes_in_solution_space, int *solutions_to_skip) {
+int count_group_members(Board board, BCB *block, int cell_index, ScatterType group_line) {
 
     /*
-        This function is responsible for finding the next leaf in the solution space tree.
+        This function is responsible for counting the unknown cells with the same value of the given cell in the given line, the cell included.
     */
 
     /*
         Parameters:
             board: the board to be solved
             block: the BCB to analyze
+            cell_index: the index of a member of the group
+            group_line: the line of the group, the row (ROWS) or the column (COLS) of the cell
+    */
+
+    int i, member_index, count = 0;
+    int x = cell_index / board.cols_count, y = cell_index % board.cols_count;
+    const int *positions;
+    int positions_count = group_line == ROWS ? row_occurrences(board, x, board.grid[cell_index], &positions) : col_occurrences(board, y, board.grid[cell_index], &positions);
+
+    for (i = 0; i < positions_count; i++) {
+        member_index = group_line == ROWS ? x * board.cols_count + positions[i] : positions[i] * board.cols_count + y;
+        if (block->solution[member_index] == UNKNOWN)
+            count++;
+    }
+    return count;
+}
+
+int next_group_member(Board board, BCB *block, int cell_index, ScatterType group_line) {
+
+    /*
+        This function is responsible for finding the first unknown cell with the same value of the given cell in the given line,
+        other than the cell itself. It returns the index of the cell in the board, or -1 if the group has no unknown members left.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to analyze
+            cell_index: the index of a member of the group
+            group_line: the line of the group, the row (ROWS) or the column (COLS) of the cell
+    */
+
+    int i, member_index;
+    int x = cell_index / board.cols_count, y = cell_index % board.cols_count;
+    const int *positions;
+    int positions_count = group_line == ROWS ? row_occurrences(board, x, board.grid[cell_index], &positions) : col_occurrences(board, y, board.grid[cell_index], &positions);
+
+    for (i = 0; i < positions_count; i++) {
+        member_index = group_line == ROWS ? x * board.cols_count + positions[i] : positions[i] * board.cols_count + y;
+        if (member_index != cell_index && block->solution[member_index] == UNKNOWN)
+            return member_index;
+    }
+    return -1;
+}
+
+int count_unknown_conflicts(Board board, BCB *block, int cell_index) {
+
+    /*
+        This function is responsible for counting the unknown cells with the same value of the given cell in its row and column.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to analyze
+            cell_index: the index of the cell in the board
+    */
+
+    int i, count, x = cell_index / board.cols_count, y = cell_index % board.cols_count;
+    int cell_value = board.grid[cell_index], conflicts = 0;
+    const int *positions;
+
+    count = row_occurrences(board, x, cell_value, &positions);
+    for (i = 0; i < count; i++)
+        if (positions[i] != y && block->solution[x * board.cols_count + positions[i]] == UNKNOWN)
+            conflicts++;
+    count = col_occurrences(board, y, cell_value, &positions);
+    for (i = 0; i < count; i++)
+        if (positions[i] != x && block->solution[positions[i] * board.cols_count + y] == UNKNOWN)
+            conflicts++;
+    return conflicts;
+}
+
+int count_unknown_neighbours(Board board, BCB *block, int cell_index) {
+
+    /*
+        This function is responsible for counting the unknown orthogonal neighbours of the given cell.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to analyze
+            cell_index: the index of the cell in the board
+    */
+
+    int x = cell_index / board.cols_count, y = cell_index % board.cols_count, count = 0;
+    if (x > 0 && block->solution[cell_index - board.cols_count] == UNKNOWN) count++;
+    if (x < board.rows_count - 1 && block->solution[cell_index + board.cols_count] == UNKNOWN) count++;
+    if (y > 0 && block->solution[cell_index - 1] == UNKNOWN) count++;
+    if (y < board.cols_count - 1 && block->solution[cell_index + 1] == UNKNOWN) count++;
+    return count;
+}
+
+bool next_leaf(Board board, BCB *block, SolverConfig config, int **unknown_index, int **unknown_index_length, int *total_processes_in_solution_space, int *solutions_to_skip) {
+
+    /*
+        This function is responsible for finding the next leaf in the solution space tree, or for resuming the search of a paused block.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to analyze
+            config: the solver configuration, defining the branching heuristic and the value order
             unknown_index: matrix with the indexes of the unknown cells
             unknown_index_length: vector containing the number of unknown cells in each row
             total_processes_in_solution_space: number of processes working in the solution space
@@ -111,47 +423,307 @@ bool next_leaf(Board board, BCB *block, int **unknown_index, int **unknown_index
     */
 
     /*
-        Find the next white cell iterating unknowns from bottom. Change it to black and try to build the new solution.
+        Flip the last decision that still has an alternative, then build the rest of the leaf from there.
+        With the conflict analysis, the decisions that split the white cells of the leaf are found and the search jumps back to the deepest one.
     */
 
-    int i, j, board_y_index;
-    CellState cell_state;
-    for (i = board.rows_count - 1; i >= 0; i--) {
-        for (j = (*unknown_index_length)[i] - 1; j >= 0; j--) {
-            board_y_index = (*unknown_index)[i * board.cols_count + j];
-            cell_state = block->solution[i * board.cols_count + board_y_index];
+    if (block->paused) {
+        block->paused = false;
+        return build_leaf(board, block, config, unknown_index, unknown_index_length, total_processes_in_solution_space, solutions_to_skip);
+    }
 
-            if (block->solution_space_unknowns[i * board.cols_count + j]) {
-                if (block->solution[i * board.cols_count + board_y_index] == UNKNOWN){
-                    printf("[Next leaf] Solution space set unknown is unknown\n");
-                    exit(-1);
-                }
-                return false;
-            }
+    block->learning = config.learning && *total_processes_in_solution_space == 1;
+    if (block->learning) {
+        explain_leaf_conflict(board, block);
+        if (!backjump(board, block))
+            return false;
+    } else if (!backtrack(board, block))
+        return false;
+    return build_leaf(board, block, config, unknown_index, unknown_index_length, total_processes_in_solution_space, solutions_to_skip);
+}
 
-            if (cell_state == UNKNOWN) {
-                printf("[ERROR] Unexpected cell state: unknown\n");
-                return false;
-            }
+bool backtrack(Board board, BCB *block) {
 
-            if (cell_state == WHITE) {
-                if (is_cell_state_valid(board, block, i, board_y_index, BLACK)) {
-                    block->solution[i * board.cols_count + board_y_index] = BLACK;
-                    if(build_leaf(board, block, i, j + 1, unknown_index, unknown_index_length, total_processes_in_solution_space, solutions_to_skip))
-                        return true;
-                }
-            }
+    /*
+        This function is responsible for moving the search to the next branch: it pops the decisions whose alternative has already been tried,
+        undoing their assignments, and flips the first one whose alternative state can still be applied.
+        It returns false when the decision stack is empty, meaning that the solution space has been fully explored.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update
+    */
 
-            block->solution[i * board.cols_count + board_y_index] = UNKNOWN;
+    while (block->decisions_count > 0) {
+        Decision *decision = &block->decisions[block->decisions_count - 1];
+        undo_trail(board, block, decision->trail_mark);
+
+        if (!decision->alternative_tried) {
+            decision->alternative_tried = true;
+            if (apply_decision(board, block, decision, decision->first_state == WHITE ? BLACK : WHITE))
+                return true;
         }
+        block->decisions_count--;
     }
     return false;
 }
 
-void init_solution_space(Board board, BCB* block, int solution_space_id, int **unknown_index) {
+void init_restarts(Board board, BCB *block, unsigned int seed) {
+
+    /*
+        This function is responsible for preparing the restarts of a block: the unknown cells of the pruned board are put in a random order
+        and each cell gets a random phase, drawn from the given seed.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved, with the pruned solution
+            block: the BCB to update
+            seed: the seed of the random orders, specific to the worker
+    */
+
+    int cell_index;
+
+    block->cell_order = (int *) malloc(board.rows_count * board.cols_count * sizeof(int));
+    block->phases = (CellState *) malloc(board.rows_count * board.cols_count * sizeof(CellState));
+    block->order_length = 0;
+    for (cell_index = 0; cell_index < board.rows_count * board.cols_count; cell_index++)
+        if (board.solution[cell_index] == UNKNOWN)
+            block->cell_order[block->order_length++] = cell_index;
+
+    block->random_state = seed;
+    block->restarts = 0;
+    block->restart_nodes = 0;
+    shuffle_restart_order(board, block);
+}
+
+void shuffle_restart_order(Board board, BCB *block) {
+
+    /*
+        This function is responsible for drawing a new random order of the cells, with a Fisher-Yates shuffle, and a new random phase for each cell.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update, with the restarts prepared
+    */
+
+    int i, j, cell_index;
+    for (i = block->order_length - 1; i > 0; i--) {
+        block->random_state = block->random_state * 1103515245 + 12345;
+        j = (block->random_state >> 16) % (i + 1);
+        cell_index = block->cell_order[i];
+        block->cell_order[i] = block->cell_order[j];
+        block->cell_order[j] = cell_index;
+    }
+    for (i = 0; i < block->order_length; i++) {
+        block->random_state = block->random_state * 1103515245 + 12345;
+        block->phases[block->cell_order[i]] = (block->random_state >> 16) & 1 ? BLACK : WHITE;
+    }
+}
+
+void restart_search(Board board, BCB *block) {
+
+    /*
+        This function is responsible for restarting the search of a block: all its decisions are undone, back to the cells assumed
+        by the block, and the cells and phases are shuffled again. The nogoods are kept, they hold whatever the order.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to restart, with the restarts prepared
+    */
+
+    if (block->decisions_count > 0)
+        undo_trail(board, block, block->decisions[0].trail_mark);
+    block->decisions_count = 0;
+    block->restarts++;
+    block->restart_nodes = 0;
+    shuffle_restart_order(board, block);
+}
+
+bool apply_decision(Board board, BCB *block, Decision *decision, CellState cell_state) {
+
+    /*
+        This function is responsible for applying a decision to the block and propagating its consequences.
+        If the state is not valid or the propagation leads to a conflict, the block is restored to the decision trail mark and false is returned.
+        Since is_cell_state_valid rejects the black cells closing a diagonal chain, a decision never splits the white cells.
+        With the conflict analysis, a propagation violating a recorded nogood is a conflict too, and the levels of the conflict are computed
+        before the block is restored.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update
+            decision: the decision to apply
+            cell_state: the state to assign to the decided cell (WHITE or BLACK)
+    */
+
+    int nogood_index;
+
+    if (!is_cell_state_valid(board, block, decision->cell / board.cols_count, decision->cell % board.cols_count, cell_state)) {
+        if (block->learning) {
+            block->conflict_cell = decision->cell;
+            block->conflict_state = cell_state;
+            block->conflict_source = -1;
+            explain_conflict(board, block);
+        }
+        return false;
+    }
+
+    assign_cell(board, block, decision->cell, cell_state);
+    block->nodes++;
+    block->restart_nodes++;
+
+    if (!propagate(board, block, decision->trail_mark)) {
+        if (block->learning)
+            explain_conflict(board, block);
+        undo_trail(board, block, decision->trail_mark);
+        return false;
+    }
+
+    if (block->learning && (nogood_index = find_violated_nogood(board, block)) != -1) {
+        explain_nogood(board, block, nogood_index);
+        undo_trail(board, block, decision->trail_mark);
+        return false;
+    }
+    return true;
+}
+
+bool propagate(Board board, BCB *block, int trail_head) {
+
+    /*
+        This function is responsible for propagating the assignments on the trail from trail_head onwards, using the trail itself as the queue:
+            - the neighbours of a black cell are forced to white
+            - the cells with the same value of a white cell, in its row and column, are forced to black
+        The forced cells are appended to the trail, so they are undone together with the decision that caused them.
+        It returns false as soon as a forced cell cannot take its state, recording the cell it was propagating as the source of the conflict.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update
+            trail_head: the index of the first trail entry to propagate
+    */
+
+    int i, x, y, cell_index, cell_value, count;
+    int neighbours[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    const int *positions;
+
+    while (trail_head < block->trail_size) {
+        cell_index = block->trail[trail_head++];
+        x = cell_index / board.cols_count;
+        y = cell_index % board.cols_count;
+
+        if (block->solution[cell_index] == BLACK) {
+            for (i = 0; i < 4; i++) {
+                int neighbour_x = x + neighbours[i][0];
+                int neighbour_y = y + neighbours[i][1];
+                if (neighbour_x < 0 || neighbour_x >= board.rows_count || neighbour_y < 0 || neighbour_y >= board.cols_count) continue;
+                if (!force_cell(board, block, neighbour_x, neighbour_y, WHITE)) {
+                    block->conflict_source = cell_index;
+                    return false;
+                }
+            }
+        } else {
+            cell_value = board.grid[cell_index];
+            count = row_occurrences(board, x, cell_value, &positions);
+            for (i = 0; i < count; i++)
+                if (positions[i] != y && !force_cell(board, block, x, positions[i], BLACK)) {
+                    block->conflict_source = cell_index;
+                    return false;
+                }
+            count = col_occurrences(board, y, cell_value, &positions);
+            for (i = 0; i < count; i++)
+                if (positions[i] != x && !force_cell(board, block, positions[i], y, BLACK)) {
+                    block->conflict_source = cell_index;
+                    return false;
+                }
+        }
+    }
+    return true;
+}
+
+bool force_cell(Board board, BCB *block, int x, int y, CellState cell_state) {
+
+    /*
+        This function is responsible for forcing a cell to a state during the propagation.
+        A cell already in the state is left untouched, a cell in the opposite state or that cannot take the state is a conflict,
+        and it is recorded on the block as the cell of the last conflict.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update
+            x: the row index of the cell
+            y: the column index of the cell
+            cell_state: the state the cell is forced to (WHITE or BLACK)
+    */
+
+    CellState current_state = block->solution[x * board.cols_count + y];
+    if (current_state == cell_state) return true;
+    if (current_state != UNKNOWN || !is_cell_state_valid(board, block, x, y, cell_state)) {
+        block->conflict_cell = x * board.cols_count + y;
+        block->conflict_state = cell_state;
+        return false;
+    }
+
+    assign_cell(board, block, x * board.cols_count + y, cell_state);
+    return true;
+}
+
+void assign_cell(Board board, BCB *block, int cell_index, CellState cell_state) {
+
+    /*
+        This function is responsible for assigning a state to an unknown cell of the block during the search, recording it on the trail
+        with the number of decisions in the stack as its level.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update
+            cell_index: the index of the cell in the board
+            cell_state: the state to assign (WHITE or BLACK)
+    */
+
+    set_cell_state(board, block, cell_index / board.cols_count, cell_index % board.cols_count, cell_state);
+    block->trail[block->trail_size++] = cell_index;
+    block->cell_levels[cell_index] = block->decisions_count;
+}
+
+void undo_trail(Board board, BCB *block, int trail_mark) {
+
+    /*
+        This function is responsible for resetting to unknown all the cells assigned after the given trail mark.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update
+            trail_mark: the size of the trail to go back to
+    */
+
+    int cell_index;
+    while (block->trail_size > trail_mark) {
+        cell_index = block->trail[--block->trail_size];
+        set_cell_state(board, block, cell_index / board.cols_count, cell_index % board.cols_count, UNKNOWN);
+    }
+}
+
+bool init_solution_space(Board board, BCB* block, int solution_space_id, int **unknown_index) {
 
     /*
         This function is responsible for initializing the solution spaces.
+        It returns false when the solution space is empty, the block has no leaves to explore.
     */
 
     /*
@@ -171,6 +743,8 @@ void init_solution_space(Board board, BCB* block, int solution_space_id, int **u
 
     memcpy(block->solution, board.solution, board.rows_count * board.cols_count * sizeof(CellState));
     memset(block->solution_space_unknowns, false, board.rows_count * board.cols_count * sizeof(bool));
+    compute_block_state(board, block);
+    block->nodes = 0;
 
     int i, j;
     int uk_idx, cell_choice, temp_solution_space_id = SOLUTION_SPACES - 1;
@@ -184,15 +758,14 @@ void init_solution_space(Board board, BCB* block, int solution_space_id, int **u
             /*
                 Validate if cell_choice (black or white) here is valid:
                     If not valid, use the other choice
-                    If neither are valid, set to unknown (then the loop will change it later)
+                    If neither are valid, the cells already defined leave no state to the cell and the solution space is empty
             */
 
             if (!is_cell_state_valid(board, block, i, uk_idx, cell_choice)) {
                 cell_choice = abs(cell_choice - 1);
                 if (!is_cell_state_valid(board, block, i, uk_idx, cell_choice)) {
-                    cell_choice = UNKNOWN;
-                    printf("[Error] Solution space invalid at cell id %d\n", i * board.cols_count + uk_idx);
-                    continue;
+                    if (DEBUG) printf("[INFO] Solution space %d is empty at cell id %d\n", solution_space_id, i * board.cols_count + uk_idx);
+                    return false;
                 }
             }
 
@@ -200,7 +773,7 @@ void init_solution_space(Board board, BCB* block, int solution_space_id, int **u
                 If the cell_choice is valid, update the solution the block and the solution space unknowns
             */
 
-            block->solution[i * board.cols_count + uk_idx] = cell_choice;
+            set_cell_state(board, block, i, uk_idx, cell_choice);
             block->solution_space_unknowns[i * board.cols_count + j] = true;
 
             if (solution_space_id > 0)
@@ -216,6 +789,8 @@ void init_solution_space(Board board, BCB* block, int solution_space_id, int **u
         if (temp_solution_space_id == 0)
             break;
     }
+
+    return true;
 }
 
 void compute_unknowns(Board board, int **unknown_index, int **unknown_index_length) {
@@ -260,3 +835,218 @@ void compute_unknowns(Board board, int **unknown_index, int **unknown_index_leng
             (*unknown_index)[i * board.cols_count + temp_index] = -1;
     }
 }
+
+void set_cell_state(Board board, BCB *block, int x, int y, CellState cell_state) {
+
+    /*
+        This function is responsible for changing the state of a cell of the block, keeping the white counters, the bit rows and the black chains updated.
+        A black cell must be reset in the reverse order in which it was set, as the trail does.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update
+            x: the row index of the cell
+            y: the column index of the cell
+            cell_state: the new state of the cell (WHITE, BLACK or UNKNOWN)
+    */
+
+    int cell_index = x * board.cols_count + y;
+    int cell_value = board.grid[cell_index];
+    int words_per_row = WORDS_PER_ROW(board.cols_count);
+
+    if (block->solution[cell_index] == WHITE) {
+        block->row_white_counts[x * (board.cols_count + 1) + cell_value]--;
+        block->col_white_counts[y * (board.rows_count + 1) + cell_value]--;
+        clear_bit(block->white_rows, words_per_row, x, y);
+    } else if (block->solution[cell_index] == BLACK) {
+        clear_bit(block->black_rows, words_per_row, x, y);
+        remove_black_cell(board, &block->chains, x, y);
+    }
+
+    if (cell_state == WHITE) {
+        block->row_white_counts[x * (board.cols_count + 1) + cell_value]++;
+        block->col_white_counts[y * (board.rows_count + 1) + cell_value]++;
+        set_bit(block->white_rows, words_per_row, x, y);
+    } else if (cell_state == BLACK) {
+        set_bit(block->black_rows, words_per_row, x, y);
+        add_black_cell(board, &block->chains, block->solution, x, y);
+    }
+
+    block->solution[cell_index] = cell_state;
+}
+
+void compute_block_state(Board board, BCB *block) {
+
+    /*
+        This function is responsible for allocating and computing the white counters, the bit rows and the black chains of a block from its solution.
+        The trail, the decision stack and the nogood store are allocated empty.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB whose counters and bit rows are computed
+    */
+
+    int words_per_row = WORDS_PER_ROW(board.cols_count);
+    int conflict_words = CONFLICT_WORDS(board.rows_count * board.cols_count);
+
+    block->row_white_counts = (int *) calloc(board.rows_count * (board.cols_count + 1), sizeof(int));
+    block->col_white_counts = (int *) calloc(board.cols_count * (board.rows_count + 1), sizeof(int));
+    block->white_rows = (uint64_t *) calloc(board.rows_count * words_per_row, sizeof(uint64_t));
+    block->black_rows = (uint64_t *) calloc(board.rows_count * words_per_row, sizeof(uint64_t));
+    block->trail = (int *) malloc(board.rows_count * board.cols_count * sizeof(int));
+    block->decisions = (Decision *) malloc(board.rows_count * board.cols_count * sizeof(Decision));
+    block->cell_levels = (int *) calloc(board.rows_count * board.cols_count, sizeof(int));
+    block->decision_reasons = (uint64_t *) malloc(board.rows_count * board.cols_count * conflict_words * sizeof(uint64_t));
+    block->conflict_levels = (uint64_t *) malloc(conflict_words * sizeof(uint64_t));
+    block->trail_size = 0;
+    block->decisions_count = 0;
+    block->learning = false;
+    block->conflict_budget = 0;
+    block->paused = false;
+    block->cell_order = NULL;
+    block->phases = NULL;
+    block->order_length = 0;
+    block->random_state = 0;
+    block->restarts = 0;
+    block->restart_nodes = 0;
+    init_black_chains(board, &block->chains);
+    init_nogood_store(&block->nogoods);
+
+    int i, j;
+    for (i = 0; i < board.rows_count; i++) {
+        for (j = 0; j < board.cols_count; j++) {
+            if (block->solution[i * board.cols_count + j] == WHITE) {
+                int cell_value = board.grid[i * board.cols_count + j];
+                block->row_white_counts[i * (board.cols_count + 1) + cell_value]++;
+                block->col_white_counts[j * (board.rows_count + 1) + cell_value]++;
+                set_bit(block->white_rows, words_per_row, i, j);
+            } else if (block->solution[i * board.cols_count + j] == BLACK)
+                set_bit(block->black_rows, words_per_row, i, j);
+        }
+    }
+
+    compute_black_chains(board, block);
+}
+
+void compute_black_chains(Board board, BCB *block) {
+
+    /*
+        This function is responsible for rebuilding the black chains of a block from its solution.
+        The black cells outside the trail are added first, then the ones in the trail in trail order, so that backtracking can undo them.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB whose black chains are rebuilt
+    */
+
+    int i, j;
+    bool in_trail[board.rows_count * board.cols_count];
+    memset(in_trail, false, board.rows_count * board.cols_count * sizeof(bool));
+    for (i = 0; i < block->trail_size; i++)
+        in_trail[block->trail[i]] = true;
+
+    reset_black_chains(board, &block->chains);
+    for (i = 0; i < board.rows_count; i++)
+        for (j = 0; j < board.cols_count; j++)
+            if (block->solution[i * board.cols_count + j] == BLACK && !in_trail[i * board.cols_count + j])
+                add_black_cell(board, &block->chains, block->solution, i, j);
+
+    for (i = 0; i < block->trail_size; i++)
+        if (block->solution[block->trail[i]] == BLACK)
+            add_black_cell(board, &block->chains, block->solution, block->trail[i] / board.cols_count, block->trail[i] % board.cols_count);
+}
+
+void copy_block(Board board, BCB *destination, BCB *source) {
+
+    /*
+        This function is responsible for creating a deep copy of a block.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            destination: the BCB to be filled with the copy
+            source: the BCB to be copied
+    */
+
+    int words_count = board.rows_count * WORDS_PER_ROW(board.cols_count);
+    int conflict_words = CONFLICT_WORDS(board.rows_count * board.cols_count);
+
+    destination->solution = malloc(board.rows_count * board.cols_count * sizeof(CellState));
+    destination->solution_space_unknowns = malloc(board.rows_count * board.cols_count * sizeof(bool));
+    destination->row_white_counts = malloc(board.rows_count * (board.cols_count + 1) * sizeof(int));
+    destination->col_white_counts = malloc(board.cols_count * (board.rows_count + 1) * sizeof(int));
+    destination->white_rows = malloc(words_count * sizeof(uint64_t));
+    destination->black_rows = malloc(words_count * sizeof(uint64_t));
+    destination->trail = malloc(board.rows_count * board.cols_count * sizeof(int));
+    destination->decisions = malloc(board.rows_count * board.cols_count * sizeof(Decision));
+    destination->cell_levels = malloc(board.rows_count * board.cols_count * sizeof(int));
+    destination->decision_reasons = malloc(board.rows_count * board.cols_count * conflict_words * sizeof(uint64_t));
+    destination->conflict_levels = malloc(conflict_words * sizeof(uint64_t));
+
+    memcpy(destination->solution, source->solution, board.rows_count * board.cols_count * sizeof(CellState));
+    memcpy(destination->solution_space_unknowns, source->solution_space_unknowns, board.rows_count * board.cols_count * sizeof(bool));
+    memcpy(destination->row_white_counts, source->row_white_counts, board.rows_count * (board.cols_count + 1) * sizeof(int));
+    memcpy(destination->col_white_counts, source->col_white_counts, board.cols_count * (board.rows_count + 1) * sizeof(int));
+    memcpy(destination->white_rows, source->white_rows, words_count * sizeof(uint64_t));
+    memcpy(destination->black_rows, source->black_rows, words_count * sizeof(uint64_t));
+    memcpy(destination->trail, source->trail, source->trail_size * sizeof(int));
+    memcpy(destination->decisions, source->decisions, source->decisions_count * sizeof(Decision));
+    memcpy(destination->cell_levels, source->cell_levels, board.rows_count * board.cols_count * sizeof(int));
+    memcpy(destination->decision_reasons, source->decision_reasons, source->decisions_count * conflict_words * sizeof(uint64_t));
+    destination->trail_size = source->trail_size;
+    destination->decisions_count = source->decisions_count;
+    destination->learning = source->learning;
+    destination->conflict_budget = source->conflict_budget;
+    destination->paused = source->paused;
+    copy_black_chains(board, &destination->chains, &source->chains);
+    copy_nogood_store(&destination->nogoods, &source->nogoods);
+    destination->nodes = 0;
+
+    destination->cell_order = NULL;
+    destination->phases = NULL;
+    if (source->cell_order != NULL) {
+        destination->cell_order = malloc(board.rows_count * board.cols_count * sizeof(int));
+        destination->phases = malloc(board.rows_count * board.cols_count * sizeof(CellState));
+        memcpy(destination->cell_order, source->cell_order, source->order_length * sizeof(int));
+        memcpy(destination->phases, source->phases, board.rows_count * board.cols_count * sizeof(CellState));
+    }
+    destination->order_length = source->order_length;
+    destination->random_state = source->random_state;
+    destination->restarts = source->restarts;
+    destination->restart_nodes = source->restart_nodes;
+}
+
+void free_block(BCB *block) {
+
+    /*
+        This function is responsible for freeing the memory of a block.
+    */
+
+    /*
+        Parameters:
+            block: the BCB to be freed
+    */
+
+    free(block->solution);
+    free(block->solution_space_unknowns);
+    free(block->row_white_counts);
+    free(block->col_white_counts);
+    free(block->white_rows);
+    free(block->black_rows);
+    free(block->trail);
+    free(block->decisions);
+    free(block->cell_levels);
+    free(block->decision_reasons);
+    free(block->conflict_levels);
+    free_black_chains(&block->chains);
+    free_nogood_store(&block->nogoods);
+    free(block->cell_order);
+    free(block->phases);
+}
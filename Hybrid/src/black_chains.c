@@ -0,0 +1,236 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/black_chains.h"
+
+/*
+    The black cells are never orthogonally adjacent, so a set of black cells splits the white cells exactly when
+    a chain of diagonally adjacent black cells closes a loop, or touches the border of the board twice.
+    The chains are tracked with a union-find where the border of the board is an extra node (index rows_count * cols_count).
+    The unions are done by size and without path compression, so that they can be undone in reverse order when a black cell is removed.
+*/
+
+void init_black_chains(Board board, BlackChains *chains) {
+
+    /*
+        This function is responsible for allocating the union-find of the black chains, with every node in its own set.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            chains: the black chains to initialize
+    */
+
+    int nodes_count = board.rows_count * board.cols_count + 1;
+
+    chains->parent = (int *) malloc(nodes_count * sizeof(int));
+    chains->size = (int *) malloc(nodes_count * sizeof(int));
+    chains->merged_roots = (int *) malloc(nodes_count * sizeof(int));
+    chains->cell_unions = (int *) malloc(nodes_count * sizeof(int));
+
+    reset_black_chains(board, chains);
+}
+
+void reset_black_chains(Board board, BlackChains *chains) {
+
+    /*
+        This function is responsible for resetting the union-find of the black chains, with every node in its own set.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            chains: the black chains to reset
+    */
+
+    int i, nodes_count = board.rows_count * board.cols_count + 1;
+    for (i = 0; i < nodes_count; i++) {
+        chains->parent[i] = i;
+        chains->size[i] = 1;
+        chains->cell_unions[i] = 0;
+    }
+    chains->merged_count = 0;
+}
+
+void copy_black_chains(Board board, BlackChains *destination, BlackChains *source) {
+
+    /*
+        This function is responsible for creating a deep copy of the black chains.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            destination: the black chains to be filled with the copy
+            source: the black chains to be copied
+    */
+
+    int nodes_count = board.rows_count * board.cols_count + 1;
+
+    destination->parent = (int *) malloc(nodes_count * sizeof(int));
+    destination->size = (int *) malloc(nodes_count * sizeof(int));
+    destination->merged_roots = (int *) malloc(nodes_count * sizeof(int));
+    destination->cell_unions = (int *) malloc(nodes_count * sizeof(int));
+
+    memcpy(destination->parent, source->parent, nodes_count * sizeof(int));
+    memcpy(destination->size, source->size, nodes_count * sizeof(int));
+    memcpy(destination->merged_roots, source->merged_roots, source->merged_count * sizeof(int));
+    memcpy(destination->cell_unions, source->cell_unions, nodes_count * sizeof(int));
+    destination->merged_count = source->merged_count;
+}
+
+void free_black_chains(BlackChains *chains) {
+
+    /*
+        This function is responsible for freeing the memory of the black chains.
+    */
+
+    /*
+        Parameters:
+            chains: the black chains to free
+    */
+
+    free(chains->parent);
+    free(chains->size);
+    free(chains->merged_roots);
+    free(chains->cell_unions);
+}
+
+int find_chain_root(BlackChains *chains, int node) {
+
+    /*
+        This function is responsible for finding the root of the chain containing the node.
+    */
+
+    /*
+        Parameters:
+            chains: the black chains
+            node: the node whose root is searched
+    */
+
+    while (chains->parent[node] != node)
+        node = chains->parent[node];
+    return node;
+}
+
+int collect_chain_roots(Board board, BlackChains *chains, CellState *solution, int x, int y, int roots[5]) {
+
+    /*
+        This function is responsible for collecting the roots of the chains that a black cell in (x, y) would touch:
+        the chains of the black cells on its diagonals and the border chain if the cell lies on the border.
+        It returns the number of roots collected, duplicates included.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            chains: the black chains
+            solution: the solution the black cells are read from
+            x: the row index of the cell
+            y: the column index of the cell
+            roots: the vector filled with the roots
+    */
+
+    int i, count = 0;
+    int diagonals[4][2] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+
+    for (i = 0; i < 4; i++) {
+        int diagonal_x = x + diagonals[i][0];
+        int diagonal_y = y + diagonals[i][1];
+        if (diagonal_x < 0 || diagonal_x >= board.rows_count || diagonal_y < 0 || diagonal_y >= board.cols_count) continue;
+        if (solution[diagonal_x * board.cols_count + diagonal_y] == BLACK)
+            roots[count++] = find_chain_root(chains, diagonal_x * board.cols_count + diagonal_y);
+    }
+
+    if (x == 0 || y == 0 || x == board.rows_count - 1 || y == board.cols_count - 1)
+        roots[count++] = find_chain_root(chains, board.rows_count * board.cols_count);
+
+    return count;
+}
+
+bool closes_black_chain(Board board, BlackChains *chains, CellState *solution, int x, int y) {
+
+    /*
+        This function is responsible for telling if blackening the cell in (x, y) would close a chain of black cells,
+        meaning that two of the chains it touches are already the same one, so the white cells would be split.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            chains: the black chains
+            solution: the solution the black cells are read from
+            x: the row index of the cell
+            y: the column index of the cell
+    */
+
+    int i, j, roots[5];
+    int count = collect_chain_roots(board, chains, solution, x, y, roots);
+
+    for (i = 0; i < count; i++)
+        for (j = i + 1; j < count; j++)
+            if (roots[i] == roots[j]) return true;
+    return false;
+}
+
+void add_black_cell(Board board, BlackChains *chains, CellState *solution, int x, int y) {
+
+    /*
+        This function is responsible for merging the black cell in (x, y) with the chains it touches.
+        The number of unions is recorded on the cell, so that remove_black_cell can undo them.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            chains: the black chains to update
+            solution: the solution the black cells are read from
+            x: the row index of the cell
+            y: the column index of the cell
+    */
+
+    int i, roots[5];
+    int cell_index = x * board.cols_count + y;
+    int count = collect_chain_roots(board, chains, solution, x, y, roots);
+
+    chains->cell_unions[cell_index] = 0;
+    for (i = 0; i < count; i++) {
+        int cell_root = find_chain_root(chains, cell_index);
+        int root = find_chain_root(chains, roots[i]);
+        if (root == cell_root) continue;
+
+        // Attach the smaller tree below the bigger one
+        int child = chains->size[root] < chains->size[cell_root] ? root : cell_root;
+        int parent = child == cell_root ? root : cell_root;
+
+        chains->parent[child] = parent;
+        chains->size[parent] += chains->size[child];
+        chains->merged_roots[chains->merged_count++] = child;
+        chains->cell_unions[cell_index]++;
+    }
+}
+
+void remove_black_cell(Board board, BlackChains *chains, int x, int y) {
+
+    /*
+        This function is responsible for undoing the unions done when the black cell in (x, y) was added.
+        The black cells must be removed in the reverse order in which they were added.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            chains: the black chains to update
+            x: the row index of the cell
+            y: the column index of the cell
+    */
+
+    int cell_index = x * board.cols_count + y;
+    while (chains->cell_unions[cell_index] > 0) {
+        int child = chains->merged_roots[--chains->merged_count];
+        chains->size[chains->parent[child]] -= chains->size[child];
+        chains->parent[child] = child;
+        chains->cell_unions[cell_index]--;
+    }
+}
@@ -0,0 +1,773 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/cdcl.h"
+
+/*
+    Conflict-driven clause learning over the cells of the board. The first two rules are binary clauses:
+        - two adjacent cells cannot both be black: white(a) or white(b)
+        - two cells with the same value in a row or column cannot both be white: black(a) or black(b)
+    The third rule has no compact encoding, so it is added lazily: when the propagation stops and the white cells are not all connected
+    through the cells that are not black, a cut clause over the black cells separating them is added as a conflict.
+    The clauses are propagated with two watched literals, the conflicts are analyzed to their first unique implication point,
+    the cells are decided by VSIDS activity with phase saving, and the search restarts on a Luby sequence of conflicts.
+*/
+
+void init_cdcl_solver(Board board, CdclSolver *solver, unsigned int seed) {
+
+    /*
+        This function is responsible for initializing a solver with the clauses of the first two rules and the cells known from the pruning.
+        The cells known are assigned at level 0, they are propagated by the first step of the search.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            solver: the solver to initialize
+            seed: the seed of the initial activities, so that the workers decide the cells in different orders
+    */
+
+    int i, j, k, cell_index, other_index, literals_count;
+    int cells_count = board.rows_count * board.cols_count;
+    int clause[2];
+
+    solver->variables_count = cells_count;
+    solver->clauses_capacity = 4 * cells_count;
+    solver->literals_capacity = 8 * cells_count;
+    solver->clause_literals = (int *) malloc(solver->literals_capacity * sizeof(int));
+    solver->clause_offsets = (int *) malloc((solver->clauses_capacity + 1) * sizeof(int));
+    solver->clause_lbds = (int *) malloc(solver->clauses_capacity * sizeof(int));
+    solver->clause_offsets[0] = 0;
+    solver->clauses_count = 0;
+
+    literals_count = 2 * cells_count;
+    solver->watches = (int **) malloc(literals_count * sizeof(int *));
+    solver->watches_count = (int *) calloc(literals_count, sizeof(int));
+    solver->watches_capacity = (int *) malloc(literals_count * sizeof(int));
+    for (i = 0; i < literals_count; i++) {
+        solver->watches_capacity[i] = 4;
+        solver->watches[i] = (int *) malloc(solver->watches_capacity[i] * sizeof(int));
+    }
+
+    solver->values = (CellState *) malloc(cells_count * sizeof(CellState));
+    solver->saved_phases = (CellState *) malloc(cells_count * sizeof(CellState));
+    solver->levels = (int *) calloc(cells_count, sizeof(int));
+    solver->reasons = (int *) malloc(cells_count * sizeof(int));
+    solver->trail = (int *) malloc(cells_count * sizeof(int));
+    solver->level_starts = (int *) malloc((cells_count + 1) * sizeof(int));
+    solver->activities = (double *) malloc(cells_count * sizeof(double));
+    solver->seen = (bool *) calloc(cells_count, sizeof(bool));
+    solver->learned = (int *) malloc((cells_count + 2) * sizeof(int));
+    solver->cut_literals = (int *) malloc((cells_count + 2) * sizeof(int));
+    solver->flood_queue = (int *) malloc(cells_count * sizeof(int));
+    solver->flood_marks = (int *) calloc(cells_count, sizeof(int));
+    solver->flood_mark = 0;
+
+    solver->trail_size = 0;
+    solver->propagation_head = 0;
+    solver->decision_level = 0;
+    solver->activity_increment = 1.0;
+    solver->restarts = 0;
+    solver->restart_conflicts = 0;
+    solver->random_state = seed;
+    solver->nodes = 0;
+    solver->max_learned = CDCL_MAX_LEARNED;
+
+    // Most of the cells of a solution are white, so white is tried first. The small random activities only break the ties of the first decisions
+    for (i = 0; i < cells_count; i++) {
+        solver->values[i] = UNKNOWN;
+        solver->saved_phases[i] = WHITE;
+        solver->reasons[i] = -1;
+        solver->random_state = solver->random_state * 1103515245 + 12345;
+        solver->activities[i] = (solver->random_state >> 16) / 65536.0 * 1e-3;
+    }
+
+    /*
+        Encode the first two rules
+    */
+
+    for (i = 0; i < board.rows_count; i++) {
+        for (j = 0; j < board.cols_count; j++) {
+            cell_index = i * board.cols_count + j;
+
+            if (j + 1 < board.cols_count) {
+                clause[0] = WHITE_LITERAL(cell_index);
+                clause[1] = WHITE_LITERAL(cell_index + 1);
+                add_cdcl_clause(solver, clause, 2, 0);
+            }
+            if (i + 1 < board.rows_count) {
+                clause[0] = WHITE_LITERAL(cell_index);
+                clause[1] = WHITE_LITERAL(cell_index + board.cols_count);
+                add_cdcl_clause(solver, clause, 2, 0);
+            }
+
+            for (k = j + 1; k < board.cols_count; k++) {
+                other_index = i * board.cols_count + k;
+                if (board.grid[other_index] != board.grid[cell_index]) continue;
+                clause[0] = BLACK_LITERAL(cell_index);
+                clause[1] = BLACK_LITERAL(other_index);
+                add_cdcl_clause(solver, clause, 2, 0);
+            }
+            for (k = i + 1; k < board.rows_count; k++) {
+                other_index = k * board.cols_count + j;
+                if (board.grid[other_index] != board.grid[cell_index]) continue;
+                clause[0] = BLACK_LITERAL(cell_index);
+                clause[1] = BLACK_LITERAL(other_index);
+                add_cdcl_clause(solver, clause, 2, 0);
+            }
+        }
+    }
+    solver->board_clauses_count = solver->clauses_count;
+
+    for (i = 0; i < cells_count; i++)
+        if (board.solution[i] != UNKNOWN)
+            assign_literal(solver, board.solution[i] == BLACK ? BLACK_LITERAL(i) : WHITE_LITERAL(i), -1);
+}
+
+void free_cdcl_solver(CdclSolver *solver) {
+
+    /*
+        This function is responsible for freeing the memory of a solver.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to be freed
+    */
+
+    int i;
+    for (i = 0; i < 2 * solver->variables_count; i++)
+        free(solver->watches[i]);
+
+    free(solver->clause_literals);
+    free(solver->clause_offsets);
+    free(solver->clause_lbds);
+    free(solver->watches);
+    free(solver->watches_count);
+    free(solver->watches_capacity);
+    free(solver->values);
+    free(solver->saved_phases);
+    free(solver->levels);
+    free(solver->reasons);
+    free(solver->trail);
+    free(solver->level_starts);
+    free(solver->activities);
+    free(solver->seen);
+    free(solver->learned);
+    free(solver->cut_literals);
+    free(solver->flood_queue);
+    free(solver->flood_marks);
+}
+
+int add_cdcl_clause(CdclSolver *solver, int *literals, int literals_count, int lbd) {
+
+    /*
+        This function is responsible for appending a clause of at least two literals to the database, watching its first two literals.
+        It returns the index of the clause.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to update
+            literals: the literals of the clause
+            literals_count: the number of literals of the clause
+            lbd: the number of distinct decision levels of the clause, 0 for the clauses of the board
+    */
+
+    int offset = solver->clause_offsets[solver->clauses_count];
+
+    if (solver->clauses_count == solver->clauses_capacity) {
+        solver->clauses_capacity *= 2;
+        solver->clause_offsets = (int *) realloc(solver->clause_offsets, (solver->clauses_capacity + 1) * sizeof(int));
+        solver->clause_lbds = (int *) realloc(solver->clause_lbds, solver->clauses_capacity * sizeof(int));
+    }
+    while (offset + literals_count > solver->literals_capacity) {
+        solver->literals_capacity *= 2;
+        solver->clause_literals = (int *) realloc(solver->clause_literals, solver->literals_capacity * sizeof(int));
+    }
+
+    int clause = solver->clauses_count++;
+    memcpy(solver->clause_literals + offset, literals, literals_count * sizeof(int));
+    solver->clause_offsets[clause + 1] = offset + literals_count;
+    solver->clause_lbds[clause] = lbd;
+
+    add_watch(solver, literals[0], clause);
+    add_watch(solver, literals[1], clause);
+    return clause;
+}
+
+void add_watch(CdclSolver *solver, int literal, int clause) {
+
+    /*
+        This function is responsible for adding a clause to the watch list of a literal, growing the list when it is full.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to update
+            literal: the watched literal
+            clause: the index of the clause watching it
+    */
+
+    if (solver->watches_count[literal] == solver->watches_capacity[literal]) {
+        solver->watches_capacity[literal] *= 2;
+        solver->watches[literal] = (int *) realloc(solver->watches[literal], solver->watches_capacity[literal] * sizeof(int));
+    }
+    solver->watches[literal][solver->watches_count[literal]++] = clause;
+}
+
+void assign_literal(CdclSolver *solver, int literal, int reason) {
+
+    /*
+        This function is responsible for making a literal true at the current decision level, recording it on the trail.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to update
+            literal: the literal made true
+            reason: the clause that forced it, -1 for a decision
+    */
+
+    int cell = LITERAL_CELL(literal);
+    solver->values[cell] = LITERAL_STATE(literal);
+    solver->levels[cell] = solver->decision_level;
+    solver->reasons[cell] = reason;
+    solver->trail[solver->trail_size++] = literal;
+}
+
+int propagate_cdcl(CdclSolver *solver) {
+
+    /*
+        This function is responsible for propagating the trail literals from the propagation head onwards with the two watched literals.
+        When a literal becomes false, each clause watching it looks for another literal that is not false to watch: if there is none,
+        the other watched literal is forced, or the clause is in conflict when it is false too.
+        The forced literal of a clause is always moved in its first position, so the conflict analysis can skip it.
+        It returns the index of the conflicting clause, or -1 if there is no conflict.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to update
+    */
+
+    int i, j, k, clause, false_literal, swap, *literals, literals_count;
+
+    while (solver->propagation_head < solver->trail_size) {
+        false_literal = NEGATE_LITERAL(solver->trail[solver->propagation_head++]);
+        int *watch_list = solver->watches[false_literal];
+        int watch_count = solver->watches_count[false_literal];
+
+        for (i = 0, j = 0; i < watch_count; i++) {
+            clause = watch_list[i];
+            literals = solver->clause_literals + solver->clause_offsets[clause];
+            literals_count = solver->clause_offsets[clause + 1] - solver->clause_offsets[clause];
+
+            // Keep the false literal in the second position
+            if (literals[0] == false_literal) {
+                literals[0] = literals[1];
+                literals[1] = false_literal;
+            }
+
+            if (IS_LITERAL_TRUE(solver->values, literals[0])) {
+                watch_list[j++] = clause;
+                continue;
+            }
+
+            // Look for a new literal to watch, the clause then leaves this watch list
+            for (k = 2; k < literals_count; k++) {
+                if (!IS_LITERAL_FALSE(solver->values, literals[k])) {
+                    swap = literals[1];
+                    literals[1] = literals[k];
+                    literals[k] = swap;
+                    add_watch(solver, literals[1], clause);
+                    break;
+                }
+            }
+            if (k < literals_count) continue;
+
+            watch_list[j++] = clause;
+            if (IS_LITERAL_FALSE(solver->values, literals[0])) {
+                // Conflict, keep the remaining watches and stop the propagation
+                for (i++; i < watch_count; i++)
+                    watch_list[j++] = watch_list[i];
+                solver->watches_count[false_literal] = j;
+                solver->propagation_head = solver->trail_size;
+                return clause;
+            }
+            assign_literal(solver, literals[0], clause);
+        }
+        solver->watches_count[false_literal] = j;
+    }
+    return -1;
+}
+
+int find_white_cut(Board board, CdclSolver *solver) {
+
+    /*
+        This function is responsible for checking the third rule on the current assignment: the white cells must be connected through the cells that are not black.
+        If they are not, a white cell u is reached from the first white cell and a white cell w is not, and the black cells around the region of either
+        separate them. The cut clause "u is black, or w is black, or one of the separating cells is white" holds in every solution, and it is false
+        under the current assignment. The smaller of the two cuts is added to the database.
+        It returns the index of the cut clause, or -1 if the white cells are connected.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            solver: the solver to update
+    */
+
+    int i, first_white = -1, other_white = -1, whites_count = 0;
+    int first_cut_count, other_cut_count;
+
+    for (i = 0; i < solver->variables_count; i++) {
+        if (solver->values[i] != WHITE) continue;
+        if (first_white == -1) first_white = i;
+        whites_count++;
+    }
+    if (first_white == -1) return -1;
+
+    if (flood_white_region(board, solver, first_white, solver->learned + 2, &first_cut_count) == whites_count)
+        return -1;
+
+    // Any white cell not reached is on the other side of the cut
+    for (i = 0; i < solver->variables_count; i++) {
+        if (solver->values[i] == WHITE && solver->flood_marks[i] != solver->flood_mark) {
+            other_white = i;
+            break;
+        }
+    }
+    flood_white_region(board, solver, other_white, solver->cut_literals + 2, &other_cut_count);
+
+    int *cut = first_cut_count <= other_cut_count ? solver->learned : solver->cut_literals;
+    int cut_count = first_cut_count <= other_cut_count ? first_cut_count : other_cut_count;
+
+    /*
+        The two literals of the highest levels are watched, as the clause is false
+    */
+
+    cut[0] = BLACK_LITERAL(first_white);
+    cut[1] = BLACK_LITERAL(other_white);
+    cut_count += 2;
+
+    int position, best, swap;
+    for (position = 0; position < 2; position++) {
+        best = position;
+        for (i = position + 1; i < cut_count; i++)
+            if (solver->levels[LITERAL_CELL(cut[i])] > solver->levels[LITERAL_CELL(cut[best])])
+                best = i;
+        swap = cut[position];
+        cut[position] = cut[best];
+        cut[best] = swap;
+    }
+
+    return add_cdcl_clause(solver, cut, cut_count, compute_lbd(solver, cut, cut_count));
+}
+
+int flood_white_region(Board board, CdclSolver *solver, int seed, int *cut, int *cut_count) {
+
+    /*
+        This function is responsible for visiting the region of the cells that are not black containing the seed, collecting the white
+        literals of the black cells around it. The reached cells and the collected black cells get a new flood mark.
+        It returns the number of white cells in the region.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            solver: the solver to analyze
+            seed: the index of the white cell the region is grown from
+            cut: the vector filled with the white literals of the black cells around the region
+            cut_count: the number of literals in the cut
+    */
+
+    int i, cell_index, neighbour_x, neighbour_y, neighbour_index;
+    int queue_head = 0, queue_size = 0, whites_count = 0;
+    int neighbours[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    int mark = ++solver->flood_mark;
+
+    *cut_count = 0;
+    solver->flood_marks[seed] = mark;
+    solver->flood_queue[queue_size++] = seed;
+
+    while (queue_head < queue_size) {
+        cell_index = solver->flood_queue[queue_head++];
+        if (solver->values[cell_index] == WHITE) whites_count++;
+
+        for (i = 0; i < 4; i++) {
+            neighbour_x = cell_index / board.cols_count + neighbours[i][0];
+            neighbour_y = cell_index % board.cols_count + neighbours[i][1];
+            if (neighbour_x < 0 || neighbour_x >= board.rows_count || neighbour_y < 0 || neighbour_y >= board.cols_count) continue;
+
+            neighbour_index = neighbour_x * board.cols_count + neighbour_y;
+            if (solver->flood_marks[neighbour_index] == mark) continue;
+            solver->flood_marks[neighbour_index] = mark;
+
+            if (solver->values[neighbour_index] == BLACK)
+                cut[(*cut_count)++] = WHITE_LITERAL(neighbour_index);
+            else
+                solver->flood_queue[queue_size++] = neighbour_index;
+        }
+    }
+    return whites_count;
+}
+
+bool resolve_conflict(CdclSolver *solver, int conflict) {
+
+    /*
+        This function is responsible for learning a clause from a conflict, backjumping and asserting it.
+        A cut clause can be false since a lower level than the current one, the search first goes back to it.
+        It returns false if the conflict does not depend on any decision, meaning the board has no solution.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to update
+            conflict: the index of the clause in conflict
+    */
+
+    int i, conflict_level = 0, learned_count;
+    for (i = solver->clause_offsets[conflict]; i < solver->clause_offsets[conflict + 1]; i++)
+        if (solver->levels[LITERAL_CELL(solver->clause_literals[i])] > conflict_level)
+            conflict_level = solver->levels[LITERAL_CELL(solver->clause_literals[i])];
+
+    if (conflict_level == 0) return false;
+    if (conflict_level < solver->decision_level)
+        backtrack_cdcl(solver, conflict_level);
+
+    int backjump_level = analyze_conflict(solver, conflict, &learned_count);
+    int lbd = compute_lbd(solver, solver->learned, learned_count);
+    backtrack_cdcl(solver, backjump_level);
+
+    if (learned_count == 1)
+        assign_literal(solver, solver->learned[0], -1);
+    else
+        assign_literal(solver, solver->learned[0], add_cdcl_clause(solver, solver->learned, learned_count, lbd));
+
+    solver->activity_increment /= 0.95;
+    solver->restart_conflicts++;
+    return true;
+}
+
+int analyze_conflict(CdclSolver *solver, int conflict, int *learned_count) {
+
+    /*
+        This function is responsible for deriving the learned clause of a conflict at the current decision level: the clause is resolved with the
+        reasons of its literals of the current level, in reverse trail order, until only one of them is left (the first unique implication point).
+        The negation of that literal is put in the first position of the learned clause, and the literal of the highest remaining level in the second one.
+        The activity of every cell involved is bumped. It returns the level to backjump to, where the learned clause forces its first literal.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to analyze
+            conflict: the index of the clause in conflict
+            learned_count: the number of literals of the learned clause, stored in the learned buffer
+    */
+
+    int i, literal, cell, clause = conflict, pending = 0, implied_literal = -1, trail_index = solver->trail_size - 1;
+    *learned_count = 1;
+
+    do {
+        for (i = solver->clause_offsets[clause]; i < solver->clause_offsets[clause + 1]; i++) {
+            literal = solver->clause_literals[i];
+            cell = LITERAL_CELL(literal);
+            if (implied_literal != -1 && cell == LITERAL_CELL(implied_literal)) continue;
+            if (solver->seen[cell] || solver->levels[cell] == 0) continue;
+
+            solver->seen[cell] = true;
+            bump_activity(solver, cell);
+            if (solver->levels[cell] >= solver->decision_level)
+                pending++;
+            else
+                solver->learned[(*learned_count)++] = literal;
+        }
+
+        // Move to the last seen literal of the trail, and resolve with its reason
+        while (!solver->seen[LITERAL_CELL(solver->trail[trail_index])])
+            trail_index--;
+        implied_literal = solver->trail[trail_index--];
+        clause = solver->reasons[LITERAL_CELL(implied_literal)];
+        solver->seen[LITERAL_CELL(implied_literal)] = false;
+        pending--;
+    } while (pending > 0);
+
+    solver->learned[0] = NEGATE_LITERAL(implied_literal);
+
+    int backjump_level = 0, highest = 1, swap;
+    for (i = 1; i < *learned_count; i++) {
+        cell = LITERAL_CELL(solver->learned[i]);
+        solver->seen[cell] = false;
+        if (solver->levels[cell] > backjump_level) {
+            backjump_level = solver->levels[cell];
+            highest = i;
+        }
+    }
+    if (*learned_count > 1) {
+        swap = solver->learned[1];
+        solver->learned[1] = solver->learned[highest];
+        solver->learned[highest] = swap;
+    }
+    return backjump_level;
+}
+
+int compute_lbd(CdclSolver *solver, int *literals, int literals_count) {
+
+    /*
+        This function is responsible for counting the distinct decision levels of the literals of a clause.
+        The clauses with fewer levels link fewer decisions and are kept longer.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to analyze
+            literals: the literals of the clause
+            literals_count: the number of literals of the clause
+    */
+
+    int i, j, level, lbd = 0;
+    for (i = 0; i < literals_count; i++) {
+        level = solver->levels[LITERAL_CELL(literals[i])];
+        for (j = 0; j < i; j++)
+            if (solver->levels[LITERAL_CELL(literals[j])] == level)
+                break;
+        if (j == i) lbd++;
+    }
+    return lbd;
+}
+
+void backtrack_cdcl(CdclSolver *solver, int level) {
+
+    /*
+        This function is responsible for unassigning the literals of the decision levels above the given one, saving their phases.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to update
+            level: the decision level to go back to
+    */
+
+    if (solver->decision_level <= level) return;
+
+    int cell;
+    while (solver->trail_size > solver->level_starts[level]) {
+        cell = LITERAL_CELL(solver->trail[--solver->trail_size]);
+        solver->saved_phases[cell] = solver->values[cell];
+        solver->values[cell] = UNKNOWN;
+        solver->reasons[cell] = -1;
+    }
+    solver->propagation_head = solver->trail_size;
+    solver->decision_level = level;
+}
+
+void bump_activity(CdclSolver *solver, int cell) {
+
+    /*
+        This function is responsible for increasing the activity of a cell involved in a conflict, rescaling all the activities before they overflow.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to update
+            cell: the index of the cell
+    */
+
+    int i;
+    solver->activities[cell] += solver->activity_increment;
+    if (solver->activities[cell] > 1e100) {
+        for (i = 0; i < solver->variables_count; i++)
+            solver->activities[i] *= 1e-100;
+        solver->activity_increment *= 1e-100;
+    }
+}
+
+int pick_branch_cell(CdclSolver *solver) {
+
+    /*
+        This function is responsible for selecting the unassigned cell with the highest activity.
+        It returns the index of the cell, or -1 if all the cells are assigned.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to analyze
+    */
+
+    int i, best_cell = -1;
+    for (i = 0; i < solver->variables_count; i++)
+        if (solver->values[i] == UNKNOWN && (best_cell == -1 || solver->activities[i] > solver->activities[best_cell]))
+            best_cell = i;
+    return best_cell;
+}
+
+void reduce_learned_clauses(CdclSolver *solver) {
+
+    /*
+        This function is responsible for deleting about half of the learned clauses, the ones with the most decision levels.
+        The binary clauses and the reasons of the assigned cells are kept. The database is compacted, and the watch lists rebuilt
+        on the first two literals of the clauses, which keeps the watches of the propagation.
+        It must be called after a complete propagation without conflicts.
+    */
+
+    /*
+        Parameters:
+            solver: the solver to update
+    */
+
+    int i, clause, literal, cell, threshold, deleted = 0, removable = 0;
+    int histogram[65] = {0};
+    bool *keep = (bool *) malloc(solver->clauses_count * sizeof(bool));
+
+    for (clause = 0; clause < solver->clauses_count; clause++) {
+        keep[clause] = true;
+        if (clause < solver->board_clauses_count || solver->clause_offsets[clause + 1] - solver->clause_offsets[clause] <= 2) continue;
+
+        literal = solver->clause_literals[solver->clause_offsets[clause]];
+        cell = LITERAL_CELL(literal);
+        if (solver->reasons[cell] == clause && IS_LITERAL_TRUE(solver->values, literal)) continue;
+
+        keep[clause] = false;
+        histogram[solver->clause_lbds[clause] > 64 ? 64 : solver->clause_lbds[clause]]++;
+        removable++;
+    }
+
+    // Find the number of levels above which half of the removable clauses are
+    for (threshold = 64; threshold > 0 && deleted + histogram[threshold] <= removable / 2; threshold--)
+        deleted += histogram[threshold];
+
+    for (clause = 0; clause < solver->clauses_count; clause++)
+        if (!keep[clause] && solver->clause_lbds[clause] <= threshold)
+            keep[clause] = true;
+
+    /*
+        Compact the database, moving the reasons to the new indexes
+    */
+
+    int *new_index = (int *) malloc(solver->clauses_count * sizeof(int));
+    int clauses_count = 0, offset = 0, length;
+    for (clause = 0; clause < solver->clauses_count; clause++) {
+        if (!keep[clause]) {
+            new_index[clause] = -1;
+            continue;
+        }
+        length = solver->clause_offsets[clause + 1] - solver->clause_offsets[clause];
+        memmove(solver->clause_literals + offset, solver->clause_literals + solver->clause_offsets[clause], length * sizeof(int));
+        solver->clause_offsets[clauses_count] = offset;
+        solver->clause_lbds[clauses_count] = solver->clause_lbds[clause];
+        new_index[clause] = clauses_count++;
+        offset += length;
+    }
+    solver->clause_offsets[clauses_count] = offset;
+    solver->clauses_count = clauses_count;
+
+    for (i = 0; i < solver->trail_size; i++) {
+        cell = LITERAL_CELL(solver->trail[i]);
+        if (solver->reasons[cell] != -1)
+            solver->reasons[cell] = new_index[solver->reasons[cell]];
+    }
+
+    for (literal = 0; literal < 2 * solver->variables_count; literal++)
+        solver->watches_count[literal] = 0;
+    for (clause = 0; clause < solver->clauses_count; clause++) {
+        add_watch(solver, solver->clause_literals[solver->clause_offsets[clause]], clause);
+        add_watch(solver, solver->clause_literals[solver->clause_offsets[clause] + 1], clause);
+    }
+
+    solver->max_learned += solver->max_learned / 10;
+    free(keep);
+    free(new_index);
+}
+
+long long luby_sequence(int index) {
+
+    /*
+        This function is responsible for computing the element of the Luby sequence (1, 1, 2, 1, 1, 2, 4, 1, ...) at the given index.
+    */
+
+    /*
+        Parameters:
+            index: the index in the sequence, starting from 0
+    */
+
+    long long size = 1;
+    int exponent = 0;
+    while (size < index + 1) {
+        exponent++;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != index) {
+        size = (size - 1) / 2;
+        exponent--;
+        index = index % size;
+    }
+    return 1LL << exponent;
+}
+
+CdclResult search_cdcl(Board board, CdclSolver *solver, long long max_conflicts) {
+
+    /*
+        This function is responsible for running the search until a solution is found, the board is proven unsolvable,
+        or max_conflicts conflicts have been resolved. A paused search resumes from where it stopped.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            solver: the solver to run
+            max_conflicts: the maximum number of conflicts of the step
+    */
+
+    int conflict, cell;
+    long long conflicts = 0;
+
+    while (true) {
+        conflict = propagate_cdcl(solver);
+        if (conflict == -1)
+            conflict = find_white_cut(board, solver);
+
+        if (conflict != -1) {
+            if (!resolve_conflict(solver, conflict))
+                return CDCL_UNSATISFIABLE;
+            if (++conflicts >= max_conflicts)
+                return CDCL_PAUSED;
+            continue;
+        }
+
+        if (solver->restart_conflicts >= luby_sequence(solver->restarts) * CDCL_RESTART_CONFLICTS) {
+            solver->restarts++;
+            solver->restart_conflicts = 0;
+            backtrack_cdcl(solver, 0);
+            continue;
+        }
+
+        if (solver->clauses_count - solver->board_clauses_count >= solver->max_learned)
+            reduce_learned_clauses(solver);
+
+        cell = pick_branch_cell(solver);
+        if (cell == -1)
+            return CDCL_SATISFIABLE;
+
+        solver->level_starts[solver->decision_level++] = solver->trail_size;
+        solver->nodes++;
+        assign_literal(solver, solver->saved_phases[cell] == BLACK ? BLACK_LITERAL(cell) : WHITE_LITERAL(cell), -1);
+    }
+}
+
+void cdcl_to_solution(Board board, CdclSolver *solver, CellState *solution) {
+
+    /*
+        This function is responsible for copying the assignment of a satisfied solver to a solution matrix.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            solver: the satisfied solver
+            solution: the solution matrix to fill
+    */
+
+    memcpy(solution, solver->values, board.rows_count * board.cols_count * sizeof(CellState));
+}
@@ -0,0 +1,417 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "../include/frontier.h"
+#include "../include/bitboard.h"
+
+/*
+    Frontier engine: a dynamic programming over the cells of the board in row-major order. After cell (i, j), the frontier is made of the last
+    cols_count cells: the cells of row i up to column j and the cells of row i - 1 after it, one per column. A state of the frontier holds:
+        - the label of each frontier cell: 0 when it is black, otherwise the connected component of the white cells it belongs to,
+          numbered in order of first appearance so that equal partitions give equal labels
+        - the later cells that cannot be white, because a white cell already swept has the same value in their row or column
+    The first two rules only involve the frontier cells and these forbidden cells, and a white component leaving the frontier without touching it again
+    can only be the last one, so the third rule is checked on the labels. Partial solutions reaching equal states have the same completions:
+    they are merged, keeping their number, so the sweep counts all the solutions at the cost of the distinct states of each layer.
+    The boards with few states in each layer, narrow or with most of the cells known from the pruning, are swept far faster than they are searched.
+*/
+
+void init_frontier_sweep(Board board, FrontierSweep *sweep) {
+
+    /*
+        This function is responsible for initializing a sweep with the empty frontier before the first cell, where the row above the board
+        counts as black without forbidding black cells in the first row. It also computes the later cells with the same value of each cell.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved, with the cells set by the pruning
+            sweep: the sweep to initialize
+    */
+
+    int i, j, k, cell_index;
+    int forbidden_words = WORDS_PER_ROW(board.rows_count * board.cols_count);
+
+    sweep->cells_count = board.rows_count * board.cols_count;
+    sweep->label_words = (board.cols_count + 7) / 8;
+    sweep->state_words = sweep->label_words + forbidden_words;
+
+    sweep->same_values = (uint64_t *) calloc(sweep->cells_count * forbidden_words, sizeof(uint64_t));
+    for (i = 0; i < board.rows_count; i++) {
+        for (j = 0; j < board.cols_count; j++) {
+            cell_index = i * board.cols_count + j;
+            for (k = j + 1; k < board.cols_count; k++)
+                if (board.grid[i * board.cols_count + k] == board.grid[cell_index])
+                    set_bit(sweep->same_values, forbidden_words, cell_index, i * board.cols_count + k);
+            for (k = i + 1; k < board.rows_count; k++)
+                if (board.grid[k * board.cols_count + j] == board.grid[cell_index])
+                    set_bit(sweep->same_values, forbidden_words, cell_index, k * board.cols_count + j);
+        }
+    }
+
+    sweep->states_capacity = 1024;
+    sweep->table_size = 2 * sweep->states_capacity;
+    sweep->states = (uint64_t *) calloc(sweep->states_capacity * sweep->state_words, sizeof(uint64_t));
+    sweep->counts = (long long *) malloc(sweep->states_capacity * sizeof(long long));
+    sweep->next_states = (uint64_t *) malloc(sweep->states_capacity * sweep->state_words * sizeof(uint64_t));
+    sweep->next_counts = (long long *) malloc(sweep->states_capacity * sizeof(long long));
+    sweep->next_origins = (long long *) malloc(sweep->states_capacity * sizeof(long long));
+    sweep->table = (int *) calloc(sweep->table_size, sizeof(int));
+    sweep->candidates_capacity = 0;
+    sweep->candidates = NULL;
+    sweep->valid = NULL;
+    sweep->origins = (long long **) malloc(sweep->cells_count * sizeof(long long *));
+
+    sweep->counts[0] = 1;
+    sweep->states_count = 1;
+    sweep->next_count = 0;
+    sweep->layers_count = 0;
+    sweep->stored_states = 0;
+    sweep->solutions_count = 0;
+    sweep->overflow = false;
+}
+
+void free_frontier_sweep(FrontierSweep *sweep) {
+
+    /*
+        This function is responsible for freeing the memory of a sweep.
+    */
+
+    /*
+        Parameters:
+            sweep: the sweep to free
+    */
+
+    int i;
+    for (i = 0; i < sweep->layers_count; i++)
+        free(sweep->origins[i]);
+    free(sweep->origins);
+    free(sweep->same_values);
+    free(sweep->states);
+    free(sweep->counts);
+    free(sweep->next_states);
+    free(sweep->next_counts);
+    free(sweep->next_origins);
+    free(sweep->table);
+    free(sweep->candidates);
+    free(sweep->valid);
+}
+
+void prepare_frontier_layer(FrontierSweep *sweep) {
+
+    /*
+        This function is responsible for making room for the two candidates of each state of the current layer, before they are expanded.
+    */
+
+    /*
+        Parameters:
+            sweep: the sweep to update
+    */
+
+    if (sweep->candidates_capacity >= 2 * sweep->states_count) return;
+
+    sweep->candidates_capacity = 2 * sweep->states_capacity;
+    free(sweep->candidates);
+    free(sweep->valid);
+    sweep->candidates = (uint64_t *) malloc(sweep->candidates_capacity * sweep->state_words * sizeof(uint64_t));
+    sweep->valid = (bool *) malloc(sweep->candidates_capacity * sizeof(bool));
+}
+
+void expand_frontier_states(Board board, FrontierSweep *sweep, int cell_index, int first, int last) {
+
+    /*
+        This function is responsible for expanding a range of states of the current layer with both states of the next cell.
+        Each state only writes its own two candidates, so the ranges can be expanded in parallel.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            sweep: the sweep to update, prepared for the layer
+            cell_index: the index of the next cell
+            first: the first state of the range
+            last: the state after the last one of the range
+    */
+
+    int i, candidate;
+    for (i = first; i < last; i++) {
+        for (candidate = 2 * i; candidate <= 2 * i + 1; candidate++)
+            sweep->valid[candidate] = expand_frontier_state(board, sweep, cell_index, sweep->states + i * sweep->state_words,
+                                                            FRONTIER_CANDIDATE_STATE(candidate), sweep->candidates + candidate * sweep->state_words);
+    }
+}
+
+bool expand_frontier_state(Board board, FrontierSweep *sweep, int cell_index, const uint64_t *state, CellState cell_state, uint64_t *child) {
+
+    /*
+        This function is responsible for computing the state reached by setting the next cell of a state, the cell taking the place
+        of the one above it in the frontier. It returns false if the cell breaks a rule:
+            - a white cell must not be forbidden, and forbids the later cells with its value in its row and column
+            - a black cell must not touch a black cell on its left or above it
+            - a white cell above a black one leaves the frontier, and when it was the last cell of its component, the component
+              is closed: it must be the only white one, which requires the other frontier cells and all the later cells to be black
+        The white cells must form a single component once the last cell is set.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved, with the cells set by the pruning
+            sweep: the sweep
+            cell_index: the index of the cell to set
+            state: the state before the cell
+            cell_state: the state of the cell
+            child: the state after the cell, written even when the cell breaks a rule
+    */
+
+    int i, row = cell_index / board.cols_count, col = cell_index % board.cols_count;
+    int forbidden_words = sweep->state_words - sweep->label_words;
+    uint8_t *labels = (uint8_t *) child;
+    uint64_t *forbidden = child + sweep->label_words;
+    const uint64_t *same_values = sweep->same_values + cell_index * forbidden_words;
+
+    if (board.solution[cell_index] != UNKNOWN && board.solution[cell_index] != cell_state) return false;
+    memcpy(child, state, sweep->state_words * sizeof(uint64_t));
+
+    uint8_t up = labels[col];
+    uint8_t left = col > 0 ? labels[col - 1] : 0;
+
+    if (cell_state == WHITE) {
+        if (get_bit(forbidden, 0, 0, cell_index)) return false;
+
+        // Join the components of the white neighbours, the cell above leaves the frontier but stays connected through this one
+        if (up != 0 && left != 0 && up != left)
+            for (i = 0; i < board.cols_count; i++)
+                if (labels[i] == left) labels[i] = up;
+        labels[col] = up != 0 ? up : left != 0 ? left : FRONTIER_NEW_LABEL;
+
+        for (i = 0; i < forbidden_words; i++)
+            forbidden[i] |= same_values[i];
+    } else {
+        if ((row > 0 && up == 0) || (col > 0 && left == 0)) return false;
+
+        labels[col] = 0;
+        if (up != 0) {
+            for (i = 0; i < board.cols_count && labels[i] != up; i++);
+            if (i == board.cols_count) {
+                // The component of the cell above is closed
+                if (cell_index < sweep->cells_count - 1) return false;
+                for (i = 0; i < board.cols_count; i++)
+                    if (labels[i] != 0) return false;
+            }
+        }
+    }
+
+    clear_bit(forbidden, 0, 0, cell_index);
+    canonicalize_frontier_labels(labels, board.cols_count);
+
+    if (cell_index == sweep->cells_count - 1)
+        for (i = 0; i < board.cols_count; i++)
+            if (labels[i] > 1) return false;
+    return true;
+}
+
+void canonicalize_frontier_labels(uint8_t *labels, int cols_count) {
+
+    /*
+        This function is responsible for renumbering the components of the white frontier cells from 1, in order of first appearance,
+        so that two frontiers with the same partition have the same labels.
+    */
+
+    /*
+        Parameters:
+            labels: the labels of the frontier cells
+            cols_count: the number of columns of the board
+    */
+
+    uint8_t renamed[256] = {0};
+    uint8_t next_label = 1;
+    int i;
+
+    for (i = 0; i < cols_count; i++) {
+        if (labels[i] == 0) continue;
+        if (renamed[labels[i]] == 0) renamed[labels[i]] = next_label++;
+        labels[i] = renamed[labels[i]];
+    }
+}
+
+uint64_t hash_frontier_state(const uint64_t *state, int words_count) {
+
+    /*
+        This function is responsible for hashing a state, mixing each word into the hash.
+    */
+
+    /*
+        Parameters:
+            state: the state to hash
+            words_count: the number of words of the state
+    */
+
+    uint64_t hash = 0x9E3779B97F4A7C15ULL;
+    int i;
+    for (i = 0; i < words_count; i++) {
+        hash = (hash ^ state[i]) * 0xBF58476D1CE4E5B9ULL;
+        hash ^= hash >> 31;
+    }
+    return hash;
+}
+
+bool merge_frontier_state(FrontierSweep *sweep, const uint64_t *state, long long count, long long origin) {
+
+    /*
+        This function is responsible for adding a candidate to the next layer: its partial solutions are added to the equal state
+        when there is one, otherwise it becomes a new state reached from the given origin.
+        It returns false, and sets the overflow flag, when the layer already has FRONTIER_MAX_LAYER_STATES states.
+    */
+
+    /*
+        Parameters:
+            sweep: the sweep to update
+            state: the candidate
+            count: the number of partial solutions reaching the candidate
+            origin: the origin of the candidate, see FRONTIER_ORIGIN
+    */
+
+    uint64_t hash = hash_frontier_state(state, sweep->state_words);
+    int slot = hash & (sweep->table_size - 1);
+    int index;
+
+    while (sweep->table[slot] != 0) {
+        index = sweep->table[slot] - 1;
+        if (memcmp(sweep->next_states + index * sweep->state_words, state, sweep->state_words * sizeof(uint64_t)) == 0) {
+            sweep->next_counts[index] = sweep->next_counts[index] > LLONG_MAX - count ? LLONG_MAX : sweep->next_counts[index] + count;
+            return true;
+        }
+        slot = (slot + 1) & (sweep->table_size - 1);
+    }
+
+    if (sweep->next_count == sweep->states_capacity) {
+        if (sweep->states_capacity == FRONTIER_MAX_LAYER_STATES) {
+            sweep->overflow = true;
+            return false;
+        }
+        grow_frontier_layers(sweep);
+        slot = hash & (sweep->table_size - 1);
+        while (sweep->table[slot] != 0)
+            slot = (slot + 1) & (sweep->table_size - 1);
+    }
+
+    index = sweep->next_count++;
+    memcpy(sweep->next_states + index * sweep->state_words, state, sweep->state_words * sizeof(uint64_t));
+    sweep->next_counts[index] = count;
+    sweep->next_origins[index] = origin;
+    sweep->table[slot] = index + 1;
+    return true;
+}
+
+void merge_frontier_candidates(FrontierSweep *sweep, int rank) {
+
+    /*
+        This function is responsible for merging the valid candidates of the current layer into the next one, in order,
+        so that the layers do not depend on how the expansion was split. It stops at the first overflow.
+    */
+
+    /*
+        Parameters:
+            sweep: the sweep to update, with the candidates expanded
+            rank: the rank of the process that expanded the candidates, 0 when the states are not split among processes
+    */
+
+    int candidate;
+    for (candidate = 0; candidate < 2 * sweep->states_count; candidate++) {
+        if (!sweep->valid[candidate]) continue;
+        if (!merge_frontier_state(sweep, sweep->candidates + candidate * sweep->state_words, sweep->counts[candidate / 2], FRONTIER_ORIGIN(rank, candidate)))
+            return;
+    }
+}
+
+void grow_frontier_layers(FrontierSweep *sweep) {
+
+    /*
+        This function is responsible for doubling the capacity of the layers, up to FRONTIER_MAX_LAYER_STATES, and rehashing the next layer.
+    */
+
+    /*
+        Parameters:
+            sweep: the sweep to update
+    */
+
+    int i, slot;
+
+    sweep->states_capacity *= 2;
+    if (sweep->states_capacity > FRONTIER_MAX_LAYER_STATES) sweep->states_capacity = FRONTIER_MAX_LAYER_STATES;
+    sweep->states = (uint64_t *) realloc(sweep->states, sweep->states_capacity * sweep->state_words * sizeof(uint64_t));
+    sweep->counts = (long long *) realloc(sweep->counts, sweep->states_capacity * sizeof(long long));
+    sweep->next_states = (uint64_t *) realloc(sweep->next_states, sweep->states_capacity * sweep->state_words * sizeof(uint64_t));
+    sweep->next_counts = (long long *) realloc(sweep->next_counts, sweep->states_capacity * sizeof(long long));
+    sweep->next_origins = (long long *) realloc(sweep->next_origins, sweep->states_capacity * sizeof(long long));
+
+    while (sweep->table_size < 2 * sweep->states_capacity) sweep->table_size *= 2;
+    free(sweep->table);
+    sweep->table = (int *) calloc(sweep->table_size, sizeof(int));
+    for (i = 0; i < sweep->next_count; i++) {
+        slot = hash_frontier_state(sweep->next_states + i * sweep->state_words, sweep->state_words) & (sweep->table_size - 1);
+        while (sweep->table[slot] != 0)
+            slot = (slot + 1) & (sweep->table_size - 1);
+        sweep->table[slot] = i + 1;
+    }
+}
+
+void finish_frontier_layer(FrontierSweep *sweep) {
+
+    /*
+        This function is responsible for making the next layer the current one, keeping the origins of its states.
+        Once the last layer is reached, its states are the solutions and their partial solutions are counted.
+        The overflow flag is set when the layers keep more than FRONTIER_MAX_STATES states in total.
+    */
+
+    /*
+        Parameters:
+            sweep: the sweep to update, with the candidates merged
+    */
+
+    int i;
+
+    sweep->origins[sweep->layers_count] = (long long *) malloc((sweep->next_count > 0 ? sweep->next_count : 1) * sizeof(long long));
+    memcpy(sweep->origins[sweep->layers_count], sweep->next_origins, sweep->next_count * sizeof(long long));
+    sweep->layers_count++;
+    sweep->stored_states += sweep->next_count;
+    if (sweep->stored_states > FRONTIER_MAX_STATES) sweep->overflow = true;
+
+    uint64_t *states = sweep->states;
+    long long *counts = sweep->counts;
+    sweep->states = sweep->next_states;
+    sweep->counts = sweep->next_counts;
+    sweep->next_states = states;
+    sweep->next_counts = counts;
+    sweep->states_count = sweep->next_count;
+    sweep->next_count = 0;
+    memset(sweep->table, 0, sweep->table_size * sizeof(int));
+
+    if (sweep->layers_count == sweep->cells_count)
+        for (i = 0; i < sweep->states_count; i++)
+            sweep->solutions_count = sweep->solutions_count > LLONG_MAX - sweep->counts[i] ? LLONG_MAX : sweep->solutions_count + sweep->counts[i];
+}
+
+void frontier_to_solution(FrontierSweep *sweep, int state_index, CellState *solution) {
+
+    /*
+        This function is responsible for rebuilding the solution ending in a state of the last layer, following the origins
+        of the states back to the first layer. The states must not be split among processes.
+    */
+
+    /*
+        Parameters:
+            sweep: the sweep, with all the layers swept
+            state_index: the index of the state in the last layer
+            solution: the solution matrix to fill
+    */
+
+    int layer, candidate;
+    for (layer = sweep->layers_count - 1; layer >= 0; layer--) {
+        candidate = FRONTIER_ORIGIN_CANDIDATE(sweep->origins[layer][state_index]);
+        solution[layer] = FRONTIER_CANDIDATE_STATE(candidate);
+        state_index = candidate / 2;
+    }
+}
@@ -15,6 +15,9 @@
 #include "../include/validation.h"
 #include "../include/backtracking.h"
 #include "../include/ipc.h"
+#include "../include/row_patterns.h"
+#include "../include/cdcl.h"
+#include "../include/frontier.h"
 
 /* ------------------ GLOBAL VARIABLES ------------------ */
 Board board;
@@ -29,6 +32,11 @@ bool process_is_solver = false;
 int process_solution_spaces, starting_solutions_to_skip;
 int *total_processes_in_solution_spaces;
 int *unknown_index, *unknown_index_length;
+long long nodes_explored = 0;
+SolverConfig config;
+
+// ----- Row patterns variables -----
+RowPatterns row_patterns;
 
 // ----- Common variables -----
 MPI_Datatype MPI_MESSAGE;
@@ -43,6 +51,13 @@ MPI_Request manager_request;   // Request for the workers to contact the manager
 bool send_status_update_message = false;
 bool send_terminate_message = false;
 
+// ----- Portfolio variables -----
+int portfolio_groups;           // Number of groups of the portfolio, each one searching the whole board with its own configuration
+int *portfolio_exhausted;       // Number of members of each group that searched their share without a solution, kept by the manager
+int *portfolio_reports;         // Members of the process that searched their share without a solution, not reported to the manager yet
+int portfolio_reports_count = 0;    // Number of members in the reports
+int portfolio_solver_group = -1;    // Group of the thread whose solution is kept by the process
+
 // ----- Manager variables -----
 Message *worker_messages;
 MPI_Request *worker_requests;   // Requests for the manager to contact the workers
@@ -188,12 +203,32 @@ void worker_check_messages() {
     }
 }
 
+void portfolio_member_exhausted(int member) {
+
+    /*
+        The manager counts the members of each group of the portfolio that searched their share without a solution.
+        When all the members of a group have, the group has proven that there is no solution and all the workers are terminated.
+    */
+
+    int i, group = member % portfolio_groups;
+    if (++portfolio_exhausted[group] < portfolio_group_size(size * omp_get_max_threads(), group) || terminated) return;
+
+    MPI_Request send_worker_request = MPI_REQUEST_NULL;
+    for (i = 0; i < size; i++) {
+        if (i == MANAGER_RANK) continue;
+        send_message(i, &send_worker_request, TERMINATE, -1, -1, false, M2W_MESSAGE);
+    }
+    #pragma omp atomic write
+    terminated = true;
+}
+
 void manager_consume_message(Message *message, int source) {
 
     /*
         Based on the message type, the manager will take the appropriate action.
 
         TERMINATE: The manager will send a TERMINATE message to all the workers
+        PORTFOLIO_EXHAUSTED: The manager will send a TERMINATE message to all the workers once all the members of a portfolio group have sent it
     */
 
     if (size == 1) return;
@@ -209,6 +244,8 @@ void manager_consume_message(Message *message, int source) {
             send_message(i, &send_worker_request, TERMINATE, source, -1, false, M2W_MESSAGE);
         }
         terminated = true;
+    } else if (message->type == PORTFOLIO_EXHAUSTED) {
+        portfolio_member_exhausted(message->data1);
     } else if (DEBUG) 
         printf("[ERROR] Process %d (manager) received an invalid message type %d from process %d\n", rank, message->type, source);
 }
@@ -268,18 +305,22 @@ void task_build_solution_space(int solution_space_id){
         fflush(stdout);
     }
     
-    // Initialize the starting block
-    BCB block = {
-        .solution = malloc(board.rows_count * board.cols_count * sizeof(CellState)),
-        .solution_space_unknowns = malloc(board.rows_count * board.cols_count * sizeof(bool))
-    };
-
-    // Fill the block 
-    init_solution_space(board, &block, solution_space_id, &unknown_index);
+    // Initialize and fill the starting block
+    BCB block;
+    bool space_found = init_solution_space(board, &block, solution_space_id, &unknown_index);
     
     int solutions_to_skip = 0, threads_in_solution_space = 1;
-    // Find the first leaf
-    bool leaf_found = build_leaf(board, &block, 0, 0, &unknown_index, &unknown_index_length, &threads_in_solution_space, &solutions_to_skip);
+
+    // With the restarts, each solution space draws its random orders from its own seed
+    SolverConfig space_config = config;
+    space_config.seed += solution_space_id;
+
+    // Find the first leaf, an empty solution space has none
+    bool leaf_found = space_found && build_leaf(board, &block, space_config, &unknown_index, &unknown_index_length, &threads_in_solution_space, &solutions_to_skip);
+
+    #pragma omp atomic
+    nodes_explored += block.nodes;
+    block.nodes = 0;
     
     if (leaf_found) {
         // If a leaf is found, check if it is a solution
@@ -344,6 +385,12 @@ void task_find_solution(int thread_id, int threads_in_solution_space, int soluti
     }
 
     bool leaf_found = false;
+    long long local_nodes = 0;
+
+    // The blocks keep the random orders drawn when their leaf was built, the seed of the thread only serves the blocks without one
+    SolverConfig thread_config = config;
+    thread_config.seed += SOLUTION_SPACES + rank * omp_get_max_threads() + thread_id;
+
     while(!terminated) {
         
         // Only the manager thread will check the messages
@@ -366,7 +413,9 @@ void task_find_solution(int thread_id, int threads_in_solution_space, int soluti
             
             // Dequeue the block from the local queue
             BCB current = dequeue(&local_queue);
-            leaf_found = next_leaf(board, &current, &unknown_index, &unknown_index_length, &threads_in_solution_space, &solutions_to_skip);
+            leaf_found = next_leaf(board, &current, thread_config, &unknown_index, &unknown_index_length, &threads_in_solution_space, &solutions_to_skip);
+            local_nodes += current.nodes;
+            current.nodes = 0;
             
             if (leaf_found) {
                 if (check_hitori_conditions(board, &current)) {
@@ -408,12 +457,144 @@ void task_find_solution(int thread_id, int threads_in_solution_space, int soluti
         }
     }
     
+    #pragma omp atomic
+    nodes_explored += local_nodes;
+
     if (DEBUG) {
         printf("[%d][%d] Exiting\n",rank , thread_id);
         fflush(stdout);
     }
 }
 
+void portfolio_check_messages() {
+
+    /*
+        The manager thread reports the members of the process that exhausted their share since the last call, then checks the messages.
+        With a single process there are no messages: the exhausted members are counted here, and a solution terminates the search right away.
+    */
+
+    int i, reports_count, reports[omp_get_max_threads()];
+
+    #pragma omp critical
+    {
+        reports_count = portfolio_reports_count;
+        memcpy(reports, portfolio_reports, reports_count * sizeof(int));
+        portfolio_reports_count = 0;
+    }
+
+    for (i = 0; i < reports_count; i++) {
+        if (size == 1)
+            portfolio_member_exhausted(reports[i]);
+        else {
+            MPI_Request exhausted_request = MPI_REQUEST_NULL;
+            send_message(MANAGER_RANK, &exhausted_request, PORTFOLIO_EXHAUSTED, reports[i], -1, false, W2M_MESSAGE);
+        }
+    }
+
+    if (size == 1) {
+        if (send_terminate_message) terminated = true;
+        return;
+    }
+    worker_check_messages();
+    if (rank == MANAGER_RANK) manager_check_messages();
+}
+
+void task_portfolio_member(int thread_id) {
+
+    /*
+        Each thread of each process is a member of the portfolio, the member m in the group m % groups. The members of a group split
+        its solution spaces and search them alone with the configuration of the group, pausing every PORTFOLIO_POLL_CONFLICTS conflicts.
+        The manager thread checks the messages at each pause, the other threads only check the termination. A thread that exhausts
+        its share queues its report for the manager thread, which keeps checking the messages until the termination.
+    */
+
+    int member = rank * omp_get_max_threads() + thread_id;
+    int group = member % portfolio_groups, group_size = portfolio_group_size(size * omp_get_max_threads(), group);
+    SolverConfig member_config = portfolio_config(config, group);
+    member_config.seed += member;
+
+    int i, threads_in_space = 1, leaves_to_skip = 0;
+    bool leaf_found, solution_found = false;
+    long long local_nodes = 0;
+    BCB block;
+
+    for (i = member / portfolio_groups; i < SOLUTION_SPACES && !terminated && !process_is_solver; i += group_size) {
+        if (!init_solution_space(board, &block, i, &unknown_index)) {
+            free_block(&block);
+            continue;
+        }
+        block.conflict_budget = PORTFOLIO_POLL_CONFLICTS;
+        leaf_found = build_leaf(board, &block, member_config, &unknown_index, &unknown_index_length, &threads_in_space, &leaves_to_skip);
+
+        while (leaf_found || block.paused) {
+            if (leaf_found && check_hitori_conditions(board, &block)) {
+                solution_found = true;
+                break;
+            }
+
+            if (thread_id == MANAGER_THREAD) portfolio_check_messages();
+            if (terminated || process_is_solver) break;
+            block.conflict_budget = PORTFOLIO_POLL_CONFLICTS;
+            leaf_found = next_leaf(board, &block, member_config, &unknown_index, &unknown_index_length, &threads_in_space, &leaves_to_skip);
+        }
+
+        local_nodes += block.nodes;
+        if (solution_found) {
+            // Only the first thread of the process finding a solution keeps it
+            #pragma omp critical
+            {
+                if (!process_is_solver) {
+                    process_is_solver = true;
+                    send_terminate_message = true;
+                    portfolio_solver_group = group;
+                    memcpy(board.solution, block.solution, board.rows_count * board.cols_count * sizeof(CellState));
+                }
+            }
+        }
+        free_block(&block);
+    }
+
+    if (!solution_found && !terminated && !process_is_solver) {
+        #pragma omp critical
+        portfolio_reports[portfolio_reports_count++] = member;
+    }
+
+    if (thread_id == MANAGER_THREAD) {
+        while (!terminated)
+            portfolio_check_messages();
+    }
+
+    #pragma omp atomic
+    nodes_explored += local_nodes;
+}
+
+bool hitori_hybrid_portfolio() {
+
+    /*
+        The threads of all the processes race on the whole board, in groups with different configurations (see portfolio_config).
+        The first process finding a solution sends TERMINATE to the manager, which forwards it to all the others, and the manager
+        terminates all the processes once all the members of a group have exhausted their share. More than one process may have found
+        a solution before the termination, the one of the lowest rank is kept.
+    */
+
+    portfolio_groups = portfolio_groups_count(size * omp_get_max_threads());
+    portfolio_reports = (int *) malloc(omp_get_max_threads() * sizeof(int));
+    if (rank == MANAGER_RANK) portfolio_exhausted = (int *) calloc(portfolio_groups, sizeof(int));
+
+    #pragma omp parallel
+    task_portfolio_member(omp_get_thread_num());
+
+    int local_winner = process_is_solver ? size - rank : 0, global_winner;
+    MPI_Allreduce(&local_winner, &global_winner, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+    free(portfolio_reports);
+    if (rank == MANAGER_RANK) free(portfolio_exhausted);
+
+    if (global_winner > 0 && global_winner == size - rank)
+        printf("[%d] Solution found by the portfolio group %d\n", rank, portfolio_solver_group);
+    return global_winner > 0 && global_winner == size - rank;
+}
+
 /* ------------------ MAIN ------------------ */
 
 bool hitori_hybrid_solution() {
@@ -526,13 +707,8 @@ bool hitori_hybrid_solution() {
                     for (j = 0; j < blocks_per_thread; j++) {
                         BCB block = dequeue(&solution_queue);
 
-                        BCB new_block = {
-                            .solution = malloc(board.rows_count * board.cols_count * sizeof(CellState)),
-                            .solution_space_unknowns = malloc(board.rows_count * board.cols_count * sizeof(bool))
-                        };
-
-                        memcpy(new_block.solution, block.solution, board.rows_count * board.cols_count * sizeof(CellState));
-                        memcpy(new_block.solution_space_unknowns, block.solution_space_unknowns, board.rows_count * board.cols_count * sizeof(bool));
+                        BCB new_block;
+                        copy_block(board, &new_block, &block);
 
                         enqueue(&solution_queue, &block);
                         enqueue(&leaf_queues[i], &new_block);
@@ -575,6 +751,246 @@ bool hitori_hybrid_solution() {
     return process_is_solver;
 }
 
+bool hitori_hybrid_row_patterns() {
+
+    /*
+        Each thread of each process searches the masks of the first row congruent to its global id. The threads search
+        ROW_SEARCH_STEPS masks at a time, then the processes agree on the termination: the search stops as soon as one of them
+        has found a solution, keeping the one of the lowest rank, or when all the threads have exhausted their masks.
+    */
+
+    int max_threads = omp_get_max_threads();
+    RowSearch *searches = (RowSearch *) malloc(max_threads * sizeof(RowSearch));
+    RowSearchResult *results = (RowSearchResult *) malloc(max_threads * sizeof(RowSearchResult));
+
+    int i, solver_thread = -1;
+    for (i = 0; i < max_threads; i++) {
+        init_row_search(board, &row_patterns, &searches[i], rank * max_threads + i, size * max_threads);
+        results[i] = ROW_SEARCH_PAUSED;
+    }
+
+    int local_state[2], global_state[2];
+    while (true) {
+        #pragma omp parallel
+        {
+            // Random pick one thread as the master that will spawn the tasks
+            #pragma omp single
+            {
+                for (i = 0; i < max_threads; i++) {
+                    #pragma omp task firstprivate(i)
+                    {
+                        if (results[i] == ROW_SEARCH_PAUSED)
+                            results[i] = search_row_patterns(board, &row_patterns, &searches[i], ROW_SEARCH_STEPS);
+                    }
+                }
+            }
+        }
+
+        // The first value identifies the lowest rank with a solution, the second one is set while a thread is still searching
+        local_state[0] = local_state[1] = 0;
+        for (i = 0; i < max_threads; i++) {
+            if (results[i] == ROW_SEARCH_FOUND && solver_thread == -1) {
+                solver_thread = i;
+                local_state[0] = size - rank;
+            }
+            if (results[i] == ROW_SEARCH_PAUSED)
+                local_state[1] = 1;
+        }
+        MPI_Allreduce(local_state, global_state, 2, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        if (global_state[0] > 0 || global_state[1] == 0) break;
+    }
+
+    bool solution_found = global_state[0] == size - rank;
+    if (solution_found) row_search_to_solution(board, &searches[solver_thread], board.solution);
+
+    for (i = 0; i < max_threads; i++) {
+        nodes_explored += searches[i].nodes;
+        free_row_search(&searches[i]);
+    }
+    free(searches);
+    free(results);
+    return solution_found;
+}
+
+bool hitori_hybrid_cdcl() {
+
+    /*
+        Each thread of each process runs its own solver on the whole board, seeded with its global id so that they decide the cells
+        in different orders. The threads resolve CDCL_SEARCH_CONFLICTS conflicts at a time, then the processes agree on the termination:
+        the search stops as soon as one of them has found a solution, keeping the one of the lowest rank, or has proven that there is none.
+    */
+
+    int max_threads = omp_get_max_threads();
+    CdclSolver *solvers = (CdclSolver *) malloc(max_threads * sizeof(CdclSolver));
+    CdclResult *results = (CdclResult *) malloc(max_threads * sizeof(CdclResult));
+
+    int i, solver_thread = -1;
+    for (i = 0; i < max_threads; i++) {
+        init_cdcl_solver(board, &solvers[i], rank * max_threads + i + 1);
+        results[i] = CDCL_PAUSED;
+    }
+
+    int local_state[2], global_state[2];
+    while (true) {
+        #pragma omp parallel
+        {
+            // Random pick one thread as the master that will spawn the tasks
+            #pragma omp single
+            {
+                for (i = 0; i < max_threads; i++) {
+                    #pragma omp task firstprivate(i)
+                    {
+                        if (results[i] == CDCL_PAUSED)
+                            results[i] = search_cdcl(board, &solvers[i], CDCL_SEARCH_CONFLICTS);
+                    }
+                }
+            }
+        }
+
+        // The first value identifies the lowest rank with a solution, the second one is set when a thread has proven there is none
+        local_state[0] = local_state[1] = 0;
+        for (i = 0; i < max_threads; i++) {
+            if (results[i] == CDCL_SATISFIABLE && solver_thread == -1) {
+                solver_thread = i;
+                local_state[0] = size - rank;
+            }
+            if (results[i] == CDCL_UNSATISFIABLE)
+                local_state[1] = 1;
+        }
+        MPI_Allreduce(local_state, global_state, 2, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        if (global_state[0] > 0 || global_state[1] > 0) break;
+    }
+
+    bool solution_found = global_state[0] == size - rank;
+    if (solution_found) cdcl_to_solution(board, &solvers[solver_thread], board.solution);
+
+    for (i = 0; i < max_threads; i++) {
+        nodes_explored += solvers[i].nodes;
+        free_cdcl_solver(&solvers[i]);
+    }
+    free(solvers);
+    free(results);
+    return solution_found;
+}
+
+bool hitori_hybrid_frontier(bool *solution_found) {
+
+    /*
+        Sweep the board cell by cell with the frontier engine, the states of each layer split among the processes by their hash,
+        so that equal states always meet on the same process. Each process expands its states with its threads, then sends each candidate
+        to the process owning it, with its number of partial solutions and its origin, then merges the candidates it receives.
+        All the solutions are counted, and the first state of the last layer on the lowest rank is rebuilt backwards,
+        each step broadcast by the process owning the state. It returns false, on all the processes, if a process exceeds
+        its maximum number of states, in which case the board has to be searched by another engine.
+    */
+
+    FrontierSweep sweep;
+    init_frontier_sweep(board, &sweep);
+    if (FRONTIER_OWNER(hash_frontier_state(sweep.states, sweep.state_words), size) != rank) sweep.states_count = 0;
+
+    int i, candidate, owner, cell_index, position;
+    int record_words = sweep.state_words + 2;
+    int *send_counts = (int *) malloc(size * sizeof(int));
+    int *send_displacements = (int *) malloc(size * sizeof(int));
+    int *receive_counts = (int *) malloc(size * sizeof(int));
+    int *receive_displacements = (int *) malloc(size * sizeof(int));
+    int *owners = NULL;
+    uint64_t *send_buffer = NULL, *receive_buffer = NULL;
+    int local_state[2], global_state[2] = {0, 1};
+
+    for (cell_index = 0; cell_index < sweep.cells_count && global_state[1] > 0; cell_index++) {
+        prepare_frontier_layer(&sweep);
+
+        #pragma omp parallel for schedule(static)
+        for (i = 0; i < sweep.states_count; i++)
+            expand_frontier_states(board, &sweep, cell_index, i, i + 1);
+
+        // Each candidate is sent as its state, its number of partial solutions and its origin
+        owners = (int *) realloc(owners, (2 * sweep.states_count + 1) * sizeof(int));
+        memset(send_counts, 0, size * sizeof(int));
+        for (candidate = 0; candidate < 2 * sweep.states_count; candidate++) {
+            if (!sweep.valid[candidate]) continue;
+            owners[candidate] = FRONTIER_OWNER(hash_frontier_state(sweep.candidates + candidate * sweep.state_words, sweep.state_words), size);
+            send_counts[owners[candidate]] += record_words;
+        }
+        MPI_Alltoall(send_counts, 1, MPI_INT, receive_counts, 1, MPI_INT, MPI_COMM_WORLD);
+
+        send_displacements[0] = receive_displacements[0] = 0;
+        for (i = 1; i < size; i++) {
+            send_displacements[i] = send_displacements[i - 1] + send_counts[i - 1];
+            receive_displacements[i] = receive_displacements[i - 1] + receive_counts[i - 1];
+        }
+        send_buffer = (uint64_t *) realloc(send_buffer, (send_displacements[size - 1] + send_counts[size - 1] + 1) * sizeof(uint64_t));
+        receive_buffer = (uint64_t *) realloc(receive_buffer, (receive_displacements[size - 1] + receive_counts[size - 1] + 1) * sizeof(uint64_t));
+
+        memset(send_counts, 0, size * sizeof(int));
+        for (candidate = 0; candidate < 2 * sweep.states_count; candidate++) {
+            if (!sweep.valid[candidate]) continue;
+            owner = owners[candidate];
+            position = send_displacements[owner] + send_counts[owner];
+            memcpy(send_buffer + position, sweep.candidates + candidate * sweep.state_words, sweep.state_words * sizeof(uint64_t));
+            send_buffer[position + sweep.state_words] = (uint64_t) sweep.counts[candidate / 2];
+            send_buffer[position + sweep.state_words + 1] = (uint64_t) FRONTIER_ORIGIN(rank, candidate);
+            send_counts[owner] += record_words;
+        }
+        MPI_Alltoallv(send_buffer, send_counts, send_displacements, MPI_UINT64_T,
+                      receive_buffer, receive_counts, receive_displacements, MPI_UINT64_T, MPI_COMM_WORLD);
+
+        for (position = 0; position < receive_displacements[size - 1] + receive_counts[size - 1] && !sweep.overflow; position += record_words)
+            merge_frontier_state(&sweep, receive_buffer + position, (long long) receive_buffer[position + sweep.state_words],
+                                 (long long) receive_buffer[position + sweep.state_words + 1]);
+        finish_frontier_layer(&sweep);
+
+        // The first value is set when a process overflows, the second one while a process has states left
+        local_state[0] = sweep.overflow;
+        local_state[1] = sweep.states_count > 0 && !sweep.overflow;
+        MPI_Allreduce(local_state, global_state, 2, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        if (global_state[0] > 0) break;
+    }
+
+    free(owners);
+    free(send_buffer);
+    free(receive_buffer);
+    free(send_counts);
+    free(send_displacements);
+    free(receive_counts);
+    free(receive_displacements);
+
+    nodes_explored += sweep.stored_states;
+    bool available = global_state[0] == 0;
+    *solution_found = false;
+    if (!available) {
+        free_frontier_sweep(&sweep);
+        return false;
+    }
+
+    long long solutions_count = 0;
+    MPI_Reduce(&sweep.solutions_count, &solutions_count, 1, MPI_LONG_LONG, MPI_SUM, MANAGER_RANK, MPI_COMM_WORLD);
+    if (rank == MANAGER_RANK) printf("[%d] Solutions counted: %lld\n", rank, solutions_count);
+
+    // The first value identifies the lowest rank with a state in the last layer
+    local_state[0] = sweep.layers_count == sweep.cells_count && sweep.states_count > 0 ? size - rank : 0;
+    MPI_Allreduce(local_state, global_state, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+    if (global_state[0] > 0) {
+        long long origin;
+        int layer, state_index = 0;
+        owner = size - global_state[0];
+        *solution_found = owner == rank;
+        for (layer = sweep.cells_count - 1; layer >= 0; layer--) {
+            if (owner == rank) origin = sweep.origins[layer][state_index];
+            MPI_Bcast(&origin, 1, MPI_LONG_LONG, owner, MPI_COMM_WORLD);
+            candidate = FRONTIER_ORIGIN_CANDIDATE(origin);
+            board.solution[layer] = FRONTIER_CANDIDATE_STATE(candidate);
+            owner = FRONTIER_ORIGIN_RANK(origin);
+            state_index = candidate / 2;
+        }
+    }
+
+    free_frontier_sweep(&sweep);
+    return true;
+}
+
 int main(int argc, char** argv) {
 
     /*
@@ -596,6 +1012,7 @@ int main(int argc, char** argv) {
     */
 
     if (rank == MANAGER_RANK) read_board(&board, argv[1]);
+    config = read_config(argc, argv);
     
     /*
         Share the board with all the processes
@@ -619,11 +1036,8 @@ int main(int argc, char** argv) {
     if (rank == MANAGER_RANK) {
 
         Board (*techniques[])(Board) = {
-            uniqueness_rule,
-            sandwich_rules,
-            pair_isolation,
-            flanked_isolation,
-            corner_cases
+            fused_basic_rules,
+            two_sat_rule
         };
         int num_techniques = sizeof(techniques) / sizeof(techniques[0]);
     
@@ -646,26 +1060,38 @@ int main(int argc, char** argv) {
     
         // Implicitly wait for all the tasks to finish
     
-        for (i = 0; i < num_techniques; i++)
-            board = combine_boards(board, partials[i], false, "Partial");
-        
         /*
-            Repeat the whiting and blacking pruning techniques until the solution doesn't change
+            Merge the partial solutions in place into the board solution, a cell marked white by a technique and black by another one
+            means that the board has no solution
         */
-    
-        while (true) {
-    
-            Board white_solution = set_white(board);
-            Board black_solution = set_black(board);
-    
-            Board partial = combine_boards(board, white_solution, false, "Partial");
-            Board new_solution = combine_boards(partial, black_solution, false, "Partial");
-    
-            if(!is_board_solution_equal(board, new_solution)) 
-                board = new_solution;
-            else 
-                break;
+
+        int cells_count = board.rows_count * board.cols_count;
+        for (i = 0; i < num_techniques; i++) {
+            int conflicts = merge_solutions(board.solution, partials[i].solution, cells_count, false);
+            free(partials[i].solution);
+
+            if (conflicts > 0) {
+                printf("[ERROR] The board has no solution, %d cells of the pruning techniques are both white and black\n", conflicts);
+                exit(-1);
+            }
         }
+        free(partials);
+        
+        /*
+            Propagate the known cells with the whiting and blacking rules until the solution doesn't change
+        */
+
+        Board propagated = fixed_point_propagation(board);
+        free(board.solution);
+        board = propagated;
+
+        /*
+            Probe the remaining unknown cells, fixing the ones whose other state leads to a conflict, until nothing changes
+        */
+
+        Board probed = failed_literal_probing(board);
+        free(board.solution);
+        board = probed;
     }
     double pruning_end_time = MPI_Wtime();
 
@@ -692,14 +1118,33 @@ int main(int argc, char** argv) {
     compute_unknowns(board, &unknown_index, &unknown_index_length);
     
     /*
-        Apply the recursive backtracking algorithm to find the solution
+        Apply the selected engine to find the solution. The row patterns engine falls back to the backtracking
+        when the board has too many columns or rows with too many legal masks, the frontier engine when it has too many columns or states,
+        the same for all the processes.
     */
 
     double recursive_start_time = MPI_Wtime();
-    bool solution_found = hitori_hybrid_solution();
+    bool solution_found;
+    if (config.engine == CDCL) {
+        solution_found = hitori_hybrid_cdcl();
+    } else if (config.engine == ROW_PATTERNS && build_row_patterns(board, &row_patterns)) {
+        solution_found = hitori_hybrid_row_patterns();
+        free_row_patterns(&row_patterns);
+    } else if (config.engine == FRONTIER && board.cols_count <= FRONTIER_MAX_COLS && hitori_hybrid_frontier(&solution_found)) {
+        // The sweep found the solution, or proved that there is none
+    } else {
+        if (config.engine == ROW_PATTERNS && rank == MANAGER_RANK)
+            printf("[%d] Row patterns not available for this board, using the backtracking\n", rank);
+        if (config.engine == FRONTIER && rank == MANAGER_RANK)
+            printf("[%d] Frontier engine not available for this board, using the backtracking\n", rank);
+        solution_found = config.portfolio ? hitori_hybrid_portfolio() : hitori_hybrid_solution();
+    }
     double recursive_end_time = MPI_Wtime();
 
     MPI_Barrier(MPI_COMM_WORLD);
+
+    long long total_nodes_explored = 0;
+    MPI_Reduce(&nodes_explored, &total_nodes_explored, 1, MPI_LONG_LONG, MPI_SUM, MANAGER_RANK, MPI_COMM_WORLD);
     
     /*
         Print all the times
@@ -711,6 +1156,8 @@ int main(int argc, char** argv) {
     
     if (rank == MANAGER_RANK) printf("[%d] Total execution time: %f\n", rank, recursive_end_time - pruning_start_time);
 
+    if (rank == MANAGER_RANK) printf("[%d] Nodes explored: %lld (%.0f nodes/sec)\n", rank, total_nodes_explored, total_nodes_explored / (recursive_end_time - recursive_start_time));
+
     MPI_Barrier(MPI_COMM_WORLD);
     
     /*
@@ -0,0 +1,478 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/nogoods.h"
+#include "../include/occurrences.h"
+#include "../include/backtracking.h"
+#include "../include/bitboard.h"
+#include "../include/black_chains.h"
+
+/*
+    Conflict learning of the backtracking search. The level of a trail cell is the number of decisions in the stack when it was assigned:
+    the propagation forces each cell from a single cell of the trail, so every cell assigned after a decision follows from that decision alone.
+    When a cell cannot take its state, the decisions responsible for the conflict are the levels of the cells blocking it and of the cell forcing it.
+    The search jumps back to the deepest of them and flips it, recording the responsible decisions as a nogood, so that the same combination
+    is refuted as soon as it shows up again in another subtree. The other levels become the reason of the flipped decision:
+    when its alternative fails too, the reason takes its place in the conflict and the search jumps further back.
+    A conflict is kept as a bit set of the levels, followed by a bit set of the cells. The cells known before the first decision have level 0:
+    the pruned ones hold on the whole board and are left out, while the ones assumed by the block, by its solution space or its cube, are kept as cells,
+    so that the nogoods hold on the whole board and can be shared. The bit 0 of the levels stands for assumed cells that are not known,
+    in the conservative reasons, and makes the nogood local to the block.
+*/
+
+void init_nogood_store(NogoodStore *store) {
+
+    /*
+        This function is responsible for allocating an empty nogood store.
+    */
+
+    /*
+        Parameters:
+            store: the nogood store to initialize
+    */
+
+    store->literals = (int *) malloc(NOGOOD_CAPACITY * NOGOOD_MAX_LITERALS * sizeof(int));
+    store->lengths = (int *) malloc(NOGOOD_CAPACITY * sizeof(int));
+    store->last_used = (long long *) malloc(NOGOOD_CAPACITY * sizeof(long long));
+    store->local = (bool *) malloc(NOGOOD_CAPACITY * sizeof(bool));
+    store->exported = (bool *) malloc(NOGOOD_CAPACITY * sizeof(bool));
+    store->count = 0;
+    store->clock = 0;
+}
+
+void copy_nogood_store(NogoodStore *destination, NogoodStore *source) {
+
+    /*
+        This function is responsible for creating a deep copy of a nogood store.
+    */
+
+    /*
+        Parameters:
+            destination: the nogood store to be filled with the copy
+            source: the nogood store to be copied
+    */
+
+    init_nogood_store(destination);
+    memcpy(destination->literals, source->literals, source->count * NOGOOD_MAX_LITERALS * sizeof(int));
+    memcpy(destination->lengths, source->lengths, source->count * sizeof(int));
+    memcpy(destination->last_used, source->last_used, source->count * sizeof(long long));
+    memcpy(destination->local, source->local, source->count * sizeof(bool));
+    memcpy(destination->exported, source->exported, source->count * sizeof(bool));
+    destination->count = source->count;
+    destination->clock = source->clock;
+}
+
+void free_nogood_store(NogoodStore *store) {
+
+    /*
+        This function is responsible for freeing the memory of a nogood store.
+    */
+
+    /*
+        Parameters:
+            store: the nogood store to be freed
+    */
+
+    free(store->literals);
+    free(store->lengths);
+    free(store->last_used);
+    free(store->local);
+    free(store->exported);
+}
+
+void add_conflict_level(Board board, BCB *block, int cell_index) {
+
+    /*
+        This function is responsible for adding the level of a known cell to the conflict. Among the cells known before the first decision,
+        the pruned ones are skipped and the ones assumed by the block are added as cells.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB whose conflict is updated
+            cell_index: the index of the cell in the board
+    */
+
+    int level = block->cell_levels[cell_index];
+    if (level > 0)
+        set_bit(block->conflict_levels, 0, 0, level);
+    else if (board.solution[cell_index] == UNKNOWN)
+        set_bit(block->conflict_levels + LEVEL_WORDS(board.rows_count * board.cols_count), 0, 0, cell_index);
+}
+
+void add_chain_levels(Board board, BCB *block, int root) {
+
+    /*
+        This function is responsible for adding to the conflict the levels of all the black cells of a chain.
+        The whole chain is taken, a superset of the cells that actually close it, which keeps the nogood valid.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB whose conflict is updated
+            root: the root of the chain in the black chains of the block
+    */
+
+    int cell_index;
+    for (cell_index = 0; cell_index < board.rows_count * board.cols_count; cell_index++)
+        if (block->solution[cell_index] == BLACK && find_chain_root(&block->chains, cell_index) == root)
+            add_conflict_level(board, block, cell_index);
+}
+
+void set_earlier_levels(Board board, uint64_t *levels, int level) {
+
+    /*
+        This function is responsible for filling a conflict with all the levels before the given one, the bit 0 of the unknown assumed cells included.
+        It is the conservative reason of a decision flipped without a conflict analysis, which makes the search jump back one decision at a time.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            levels: the conflict to fill
+            level: the first level left out
+    */
+
+    int full_words = level / BITS_PER_WORD;
+
+    memset(levels, 0, CONFLICT_WORDS(board.rows_count * board.cols_count) * sizeof(uint64_t));
+    memset(levels, 0xff, full_words * sizeof(uint64_t));
+    if (full_words < LEVEL_WORDS(board.rows_count * board.cols_count))
+        levels[full_words] = (1ULL << (level % BITS_PER_WORD)) - 1;
+}
+
+void explain_conflict(Board board, BCB *block) {
+
+    /*
+        This function is responsible for computing the levels responsible for the last conflict of the propagation, from the cell that could not take its state:
+            - a cell already in the other state is blocked by its own level
+            - a white cell is blocked by the white cells with the same value in its row and column
+            - a black cell is blocked by its black neighbours, or by the chains it would close
+        The level of the cell forcing it is added as well, or the current one when the cell was a decision.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB whose conflict is computed, with the conflict cell, state and source set
+    */
+
+    int i, j, roots[5], roots_count;
+    int cell_index = block->conflict_cell;
+    int x = cell_index / board.cols_count, y = cell_index % board.cols_count;
+    int neighbours[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    bool blocked = false;
+
+    memset(block->conflict_levels, 0, CONFLICT_WORDS(board.rows_count * board.cols_count) * sizeof(uint64_t));
+    if (block->conflict_source == -1)
+        set_bit(block->conflict_levels, 0, 0, block->decisions_count);
+    else
+        add_conflict_level(board, block, block->conflict_source);
+
+    if (block->solution[cell_index] != UNKNOWN) {
+        add_conflict_level(board, block, cell_index);
+        return;
+    }
+
+    if (block->conflict_state == WHITE) {
+        const int *positions;
+        int count = row_occurrences(board, x, board.grid[cell_index], &positions);
+        for (i = 0; i < count; i++)
+            if (positions[i] != y && block->solution[x * board.cols_count + positions[i]] == WHITE)
+                add_conflict_level(board, block, x * board.cols_count + positions[i]);
+        count = col_occurrences(board, y, board.grid[cell_index], &positions);
+        for (i = 0; i < count; i++)
+            if (positions[i] != x && block->solution[positions[i] * board.cols_count + y] == WHITE)
+                add_conflict_level(board, block, positions[i] * board.cols_count + y);
+        return;
+    }
+
+    for (i = 0; i < 4; i++) {
+        int neighbour_x = x + neighbours[i][0];
+        int neighbour_y = y + neighbours[i][1];
+        if (neighbour_x < 0 || neighbour_x >= board.rows_count || neighbour_y < 0 || neighbour_y >= board.cols_count) continue;
+        if (block->solution[neighbour_x * board.cols_count + neighbour_y] == BLACK) {
+            add_conflict_level(board, block, neighbour_x * board.cols_count + neighbour_y);
+            blocked = true;
+        }
+    }
+    if (blocked) return;
+
+    // The cell would close a chain, the chains touched twice are the ones it closes
+    roots_count = collect_chain_roots(board, &block->chains, block->solution, x, y, roots);
+    for (i = 0; i < roots_count; i++)
+        for (j = i + 1; j < roots_count; j++)
+            if (roots[i] == roots[j]) {
+                add_chain_levels(board, block, roots[i]);
+                break;
+            }
+}
+
+void explain_leaf_conflict(Board board, BCB *block) {
+
+    /*
+        This function is responsible for computing the levels responsible for a leaf that is not a solution.
+        When the white cells are split, the region of the first white cell is surrounded by black cells: these black cells, the first white cell
+        and a white cell outside the region cannot be together in a solution. Otherwise the conflict is made of all the decisions.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB holding the leaf
+    */
+
+    int i, cells_count = board.rows_count * board.cols_count;
+    int queue[cells_count], queue_head = 0, queue_size = 0, first_white = -1;
+    bool reached[cells_count];
+    int neighbours[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+    memset(reached, false, cells_count * sizeof(bool));
+    memset(block->conflict_levels, 0, CONFLICT_WORDS(cells_count) * sizeof(uint64_t));
+
+    for (i = 0; i < cells_count && first_white == -1; i++)
+        if (block->solution[i] == WHITE)
+            first_white = i;
+    if (first_white == -1) {
+        set_earlier_levels(board, block->conflict_levels, block->decisions_count + 1);
+        return;
+    }
+
+    reached[first_white] = true;
+    queue[queue_size++] = first_white;
+    while (queue_head < queue_size) {
+        int cell_index = queue[queue_head++];
+        for (i = 0; i < 4; i++) {
+            int neighbour_x = cell_index / board.cols_count + neighbours[i][0];
+            int neighbour_y = cell_index % board.cols_count + neighbours[i][1];
+            if (neighbour_x < 0 || neighbour_x >= board.rows_count || neighbour_y < 0 || neighbour_y >= board.cols_count) continue;
+            int neighbour_index = neighbour_x * board.cols_count + neighbour_y;
+            if (block->solution[neighbour_index] == BLACK)
+                add_conflict_level(board, block, neighbour_index);
+            else if (block->solution[neighbour_index] == WHITE && !reached[neighbour_index]) {
+                reached[neighbour_index] = true;
+                queue[queue_size++] = neighbour_index;
+            }
+        }
+    }
+
+    for (i = 0; i < cells_count; i++)
+        if (block->solution[i] == WHITE && !reached[i])
+            break;
+    if (i == cells_count) {
+        // The white cells are connected, the leaf breaks one of the first two rules on the cells known before the search
+        set_earlier_levels(board, block->conflict_levels, block->decisions_count + 1);
+        return;
+    }
+    add_conflict_level(board, block, first_white);
+    add_conflict_level(board, block, i);
+}
+
+void explain_nogood(Board board, BCB *block, int nogood_index) {
+
+    /*
+        This function is responsible for setting the conflict to the levels of the cells of a violated nogood.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB whose conflict is computed
+            nogood_index: the index of the nogood in the store of the block
+    */
+
+    int i;
+    int *literals = block->nogoods.literals + nogood_index * NOGOOD_MAX_LITERALS;
+
+    memset(block->conflict_levels, 0, CONFLICT_WORDS(board.rows_count * board.cols_count) * sizeof(uint64_t));
+    for (i = 0; i < block->nogoods.lengths[nogood_index]; i++)
+        add_conflict_level(board, block, literals[i] / 2);
+    if (block->nogoods.local[nogood_index])
+        block->conflict_levels[0] |= 1ULL;
+}
+
+bool backjump(Board board, BCB *block) {
+
+    /*
+        This function is responsible for moving the search to the next branch after a conflict, following the levels of the conflict:
+        the deepest responsible decision is flipped, and the decisions above it are dropped, as none of them took part in the conflict.
+        When the deepest decision has already been flipped, its reason replaces it and the search goes further back.
+        It returns false when no decision is left to flip, meaning that the solution space has been fully explored.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update, with the levels of the conflict computed
+    */
+
+    int i, level, words_count = CONFLICT_WORDS(board.rows_count * board.cols_count);
+
+    block->nogoods.clock++;
+    while ((level = find_last_bit(block->conflict_levels, LEVEL_WORDS(board.rows_count * board.cols_count))) > 0) {
+        Decision *decision = &block->decisions[level - 1];
+        uint64_t *reason = block->decision_reasons + (level - 1) * words_count;
+
+        undo_trail(board, block, decision->trail_mark);
+        block->decisions_count = level;
+
+        if (decision->alternative_tried) {
+            // Both states of the decision fail, the conflict is moved on the decisions that forced the alternative
+            clear_bit(block->conflict_levels, 0, 0, level);
+            for (i = 0; i < words_count; i++)
+                block->conflict_levels[i] |= reason[i];
+            block->decisions_count--;
+            continue;
+        }
+
+        record_nogood(board, block);
+        clear_bit(block->conflict_levels, 0, 0, level);
+        memcpy(reason, block->conflict_levels, words_count * sizeof(uint64_t));
+
+        decision->alternative_tried = true;
+        if (apply_decision(board, block, decision, decision_state(decision)))
+            return true;
+    }
+
+    if (block->decisions_count > 0)
+        undo_trail(board, block, block->decisions[0].trail_mark);
+    block->decisions_count = 0;
+    return false;
+}
+
+void record_nogood(Board board, BCB *block) {
+
+    /*
+        This function is responsible for recording the decisions and the assumed cells of the conflict as a nogood, with the states they currently hold.
+        The nogoods longer than NOGOOD_MAX_LITERALS are rarely met again and are not recorded.
+        A conflict depending on unknown assumed cells gives a local nogood.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB whose store is updated, with the levels of the conflict computed
+    */
+
+    int level, cell_index, length = 0;
+    int literals[NOGOOD_MAX_LITERALS];
+    uint64_t *assumed_cells = block->conflict_levels + LEVEL_WORDS(board.rows_count * board.cols_count);
+
+    for (level = 1; level <= block->decisions_count; level++) {
+        if (!get_bit(block->conflict_levels, 0, 0, level)) continue;
+        if (length == NOGOOD_MAX_LITERALS) return;
+        literals[length++] = 2 * block->decisions[level - 1].cell + decision_state(&block->decisions[level - 1]);
+    }
+    for (cell_index = 0; cell_index < board.rows_count * board.cols_count; cell_index++) {
+        if (!get_bit(assumed_cells, 0, 0, cell_index)) continue;
+        if (length == NOGOOD_MAX_LITERALS) return;
+        literals[length++] = 2 * cell_index + block->solution[cell_index];
+    }
+    store_nogood(&block->nogoods, literals, length, get_bit(block->conflict_levels, 0, 0, 0), false);
+}
+
+void store_nogood(NogoodStore *store, int *literals, int length, bool local, bool exported) {
+
+    /*
+        This function is responsible for adding a nogood to a store. When the store is full, the least recently used nogood is evicted:
+        the time of a nogood is refreshed every time it detects a conflict.
+    */
+
+    /*
+        Parameters:
+            store: the nogood store to update
+            literals: the cells of the nogood with their states, as 2 * cell + state
+            length: the number of cells of the nogood, at most NOGOOD_MAX_LITERALS
+            local: flag of a nogood depending on the cells assumed by the block
+            exported: flag of a nogood that must not be sent to the other workers
+    */
+
+    int i, slot;
+
+    if (store->count < NOGOOD_CAPACITY)
+        slot = store->count++;
+    else {
+        slot = 0;
+        for (i = 1; i < store->count; i++)
+            if (store->last_used[i] < store->last_used[slot])
+                slot = i;
+    }
+
+    memcpy(store->literals + slot * NOGOOD_MAX_LITERALS, literals, length * sizeof(int));
+    store->lengths[slot] = length;
+    store->last_used[slot] = store->clock;
+    store->local[slot] = local;
+    store->exported[slot] = exported;
+}
+
+int find_violated_nogood(Board board, BCB *block) {
+
+    /*
+        This function is responsible for finding a nogood whose cells all hold their states in the block, refreshing its time.
+        It returns the index of the nogood in the store, or -1 if none is violated.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to check
+    */
+
+    NogoodStore *store = &block->nogoods;
+    int i, j;
+
+    for (i = 0; i < store->count; i++) {
+        int *literals = store->literals + i * NOGOOD_MAX_LITERALS;
+        for (j = 0; j < store->lengths[i]; j++)
+            if (block->solution[literals[j] / 2] != literals[j] % 2)
+                break;
+        if (j == store->lengths[i]) {
+            store->last_used[i] = store->clock;
+            return i;
+        }
+    }
+    return -1;
+}
+
+CellState decision_state(Decision *decision) {
+
+    /*
+        This function is responsible for returning the state currently taken by a decision, the first one or the alternative.
+    */
+
+    /*
+        Parameters:
+            decision: the decision to read
+    */
+
+    if (!decision->alternative_tried)
+        return decision->first_state;
+    return decision->first_state == WHITE ? BLACK : WHITE;
+}
+
+void compute_decision_levels(Board board, BCB *block) {
+
+    /*
+        This function is responsible for rebuilding the levels of the trail cells from the trail marks of the decisions, for a block whose search state
+        has been restored. The reasons of the decisions are lost, so each decision is given all the earlier ones.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update
+    */
+
+    int i, level = 0;
+    int words_count = CONFLICT_WORDS(board.rows_count * board.cols_count);
+
+    for (i = 0; i < block->trail_size; i++) {
+        while (level < block->decisions_count && block->decisions[level].trail_mark <= i)
+            level++;
+        block->cell_levels[block->trail[i]] = level;
+    }
+    for (level = 1; level <= block->decisions_count; level++)
+        set_earlier_levels(board, block->decision_reasons + (level - 1) * words_count, level);
+}
@@ -0,0 +1,116 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/occurrences.h"
+
+ValueOccurrences *build_value_occurrences(Board board) {
+
+    /*
+        This function is responsible for building the positions of each value in each row and column of the board, once per puzzle.
+        The positions are stored in CSR layout with a counting sort: the cells of each (line, value) pair are counted, the prefix sums
+        of the counts give the first index of each pair, and the cells are then scattered in order, so the positions of a pair are increasing.
+        The rules that look for the cells with the same value of a cell iterate over its pair only, instead of rescanning the whole line.
+    */
+
+    /*
+        Parameters:
+            board: the board to be indexed, the values must be in the range [1, cols_count]
+    */
+
+    int i, j, value;
+    int row_stride = board.cols_count + 1, col_stride = board.rows_count + 1;
+    int cells_count = board.rows_count * board.cols_count;
+
+    ValueOccurrences *occurrences = (ValueOccurrences *) malloc(sizeof(ValueOccurrences));
+    occurrences->row_offsets = (int *) calloc(board.rows_count * row_stride + 1, sizeof(int));
+    occurrences->col_offsets = (int *) calloc(board.cols_count * col_stride + 1, sizeof(int));
+    occurrences->row_cols = (int *) malloc(cells_count * sizeof(int));
+    occurrences->col_rows = (int *) malloc(cells_count * sizeof(int));
+
+    // Count the cells of each pair one slot ahead, so that the prefix sums give the first index of each pair
+    for (i = 0; i < board.rows_count; i++) {
+        for (j = 0; j < board.cols_count; j++) {
+            value = board.grid[i * board.cols_count + j];
+            occurrences->row_offsets[i * row_stride + value + 1]++;
+            occurrences->col_offsets[j * col_stride + value + 1]++;
+        }
+    }
+
+    for (i = 1; i <= board.rows_count * row_stride; i++) occurrences->row_offsets[i] += occurrences->row_offsets[i - 1];
+    for (i = 1; i <= board.cols_count * col_stride; i++) occurrences->col_offsets[i] += occurrences->col_offsets[i - 1];
+
+    int *row_next = (int *) malloc(board.rows_count * row_stride * sizeof(int));
+    int *col_next = (int *) malloc(board.cols_count * col_stride * sizeof(int));
+    memcpy(row_next, occurrences->row_offsets, board.rows_count * row_stride * sizeof(int));
+    memcpy(col_next, occurrences->col_offsets, board.cols_count * col_stride * sizeof(int));
+
+    for (i = 0; i < board.rows_count; i++) {
+        for (j = 0; j < board.cols_count; j++) {
+            value = board.grid[i * board.cols_count + j];
+            occurrences->row_cols[row_next[i * row_stride + value]++] = j;
+            occurrences->col_rows[col_next[j * col_stride + value]++] = i;
+        }
+    }
+
+    free(row_next);
+    free(col_next);
+    return occurrences;
+}
+
+int row_occurrences(Board board, int row, int value, const int **cols) {
+
+    /*
+        This function is responsible for finding the columns of the cells with the given value in the given row, the cell itself included.
+        It returns the number of cells, and points cols to their columns in increasing order.
+    */
+
+    /*
+        Parameters:
+            board: the board, with its occurrences built
+            row: the index of the row
+            value: the value to look for
+            cols: the pointer set to the columns of the cells
+    */
+
+    int *offsets = board.occurrences->row_offsets + row * (board.cols_count + 1) + value;
+    *cols = board.occurrences->row_cols + offsets[0];
+    return offsets[1] - offsets[0];
+}
+
+int col_occurrences(Board board, int col, int value, const int **rows) {
+
+    /*
+        This function is responsible for finding the rows of the cells with the given value in the given column, the cell itself included.
+        It returns the number of cells, and points rows to their rows in increasing order.
+    */
+
+    /*
+        Parameters:
+            board: the board, with its occurrences built
+            col: the index of the column
+            value: the value to look for
+            rows: the pointer set to the rows of the cells
+    */
+
+    int *offsets = board.occurrences->col_offsets + col * (board.rows_count + 1) + value;
+    *rows = board.occurrences->col_rows + offsets[0];
+    return offsets[1] - offsets[0];
+}
+
+void free_value_occurrences(ValueOccurrences *occurrences) {
+
+    /*
+        This function is responsible for freeing the memory of the occurrences.
+    */
+
+    /*
+        Parameters:
+            occurrences: the occurrences to be freed
+    */
+
+    free(occurrences->row_offsets);
+    free(occurrences->row_cols);
+    free(occurrences->col_offsets);
+    free(occurrences->col_rows);
+    free(occurrences);
+}
@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/two_sat.h"
+#include "../include/occurrences.h"
+
+bool solve_two_sat(Board board, CellState *forced) {
+
+    /*
+        This function is responsible for finding every cell whose state is forced by the first two rules of the game and the cells already known.
+        Both rules are 2-clauses over the black states of two cells, so they form an implication graph between the literals of the cells:
+        a cell is forced black when its white literal implies its black one, and forced white in the opposite case.
+        The strongly connected components are computed once, the board is unsatisfiable when the two literals of a cell share a component.
+        The implications are then checked on the condensed graph, 64 target components at a time with one word per component.
+        It returns false if the board is unsatisfiable.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved, with the cells already known
+            forced: the matrix filled with the forced state of each cell, UNKNOWN if not forced
+    */
+
+    int i, l, e, c, first, cells_count = board.rows_count * board.cols_count, literals_count = 2 * cells_count;
+    int *edge_offsets, *edges;
+    build_implication_graph(board, &edge_offsets, &edges);
+
+    int *component = (int *) malloc(literals_count * sizeof(int));
+    int components_count = compute_components(literals_count, edge_offsets, edges, component);
+
+    for (i = 0; i < cells_count; i++) {
+        forced[i] = UNKNOWN;
+        if (component[BLACK_LITERAL(i)] == component[WHITE_LITERAL(i)]) {
+            free(edge_offsets);
+            free(edges);
+            free(component);
+            return false;
+        }
+    }
+
+    /*
+        Group the literals by component, so that the successors of a component can be visited
+    */
+
+    int *component_offsets = (int *) calloc(components_count + 1, sizeof(int));
+    int *component_literals = (int *) malloc(literals_count * sizeof(int));
+    for (l = 0; l < literals_count; l++)
+        component_offsets[component[l] + 1]++;
+    for (c = 0; c < components_count; c++)
+        component_offsets[c + 1] += component_offsets[c];
+    int *fill = (int *) malloc(components_count * sizeof(int));
+    memcpy(fill, component_offsets, components_count * sizeof(int));
+    for (l = 0; l < literals_count; l++)
+        component_literals[fill[component[l]]++] = l;
+    free(fill);
+
+    /*
+        The components are numbered in reverse topological order, so a component only reaches components with a lower number
+        and the ones below the current targets can be skipped.
+    */
+
+    uint64_t *reach = (uint64_t *) malloc(components_count * sizeof(uint64_t));
+    int black_component, white_component;
+
+    for (first = 0; first < components_count; first += 64) {
+        for (c = first; c < components_count; c++) {
+            uint64_t word = c < first + 64 ? 1ULL << (c - first) : 0;
+            for (l = component_offsets[c]; l < component_offsets[c + 1]; l++) {
+                for (e = edge_offsets[component_literals[l]]; e < edge_offsets[component_literals[l] + 1]; e++) {
+                    int successor = component[edges[e]];
+                    if (successor != c && successor >= first)
+                        word |= reach[successor];
+                }
+            }
+            reach[c] = word;
+        }
+
+        // A literal can only reach the chunk if its component is above the first target, the words below are left from the previous chunks
+        for (i = 0; i < cells_count; i++) {
+            black_component = component[BLACK_LITERAL(i)];
+            white_component = component[WHITE_LITERAL(i)];
+            if (black_component >= first && black_component < first + 64 && white_component > black_component && (reach[white_component] >> (black_component - first)) & 1ULL)
+                forced[i] = BLACK;
+            if (white_component >= first && white_component < first + 64 && black_component > white_component && (reach[black_component] >> (white_component - first)) & 1ULL)
+                forced[i] = WHITE;
+        }
+    }
+
+    free(edge_offsets);
+    free(edges);
+    free(component);
+    free(component_offsets);
+    free(component_literals);
+    free(reach);
+
+    return true;
+}
+
+int collect_implications(Board board, int *from, int *to) {
+
+    /*
+        This function is responsible for listing the implications of the graph, two for each clause:
+            - two adjacent cells cannot both be black: black(a) -> white(b), black(b) -> white(a)
+            - two cells with the same value in a row or column cannot both be white: white(a) -> black(b), white(b) -> black(a)
+            - a known cell is a unit clause: the negation of its state implies its state
+        When from is NULL the implications are only counted. It returns the number of implications.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            from: the vector filled with the source literal of each implication, or NULL
+            to: the vector filled with the destination literal of each implication, or NULL
+    */
+
+    int i, j, k, cell_index, other_index, positions_count, count = 0;
+    const int *positions;
+
+    for (i = 0; i < board.rows_count; i++) {
+        for (j = 0; j < board.cols_count; j++) {
+            cell_index = i * board.cols_count + j;
+
+            if (j + 1 < board.cols_count) {
+                add_implication(from, to, &count, BLACK_LITERAL(cell_index), WHITE_LITERAL(cell_index + 1));
+                add_implication(from, to, &count, BLACK_LITERAL(cell_index + 1), WHITE_LITERAL(cell_index));
+            }
+            if (i + 1 < board.rows_count) {
+                add_implication(from, to, &count, BLACK_LITERAL(cell_index), WHITE_LITERAL(cell_index + board.cols_count));
+                add_implication(from, to, &count, BLACK_LITERAL(cell_index + board.cols_count), WHITE_LITERAL(cell_index));
+            }
+
+            positions_count = row_occurrences(board, i, board.grid[cell_index], &positions);
+            for (k = 0; k < positions_count; k++) {
+                if (positions[k] <= j) continue;
+                other_index = i * board.cols_count + positions[k];
+                add_implication(from, to, &count, WHITE_LITERAL(cell_index), BLACK_LITERAL(other_index));
+                add_implication(from, to, &count, WHITE_LITERAL(other_index), BLACK_LITERAL(cell_index));
+            }
+            positions_count = col_occurrences(board, j, board.grid[cell_index], &positions);
+            for (k = 0; k < positions_count; k++) {
+                if (positions[k] <= i) continue;
+                other_index = positions[k] * board.cols_count + j;
+                add_implication(from, to, &count, WHITE_LITERAL(cell_index), BLACK_LITERAL(other_index));
+                add_implication(from, to, &count, WHITE_LITERAL(other_index), BLACK_LITERAL(cell_index));
+            }
+
+            if (board.solution[cell_index] == BLACK)
+                add_implication(from, to, &count, WHITE_LITERAL(cell_index), BLACK_LITERAL(cell_index));
+            if (board.solution[cell_index] == WHITE)
+                add_implication(from, to, &count, BLACK_LITERAL(cell_index), WHITE_LITERAL(cell_index));
+        }
+    }
+
+    return count;
+}
+
+void add_implication(int *from, int *to, int *count, int source, int destination) {
+
+    /*
+        This function is responsible for appending an implication to the list, or only counting it when the list is NULL.
+    */
+
+    /*
+        Parameters:
+            from: the vector of the source literals, or NULL
+            to: the vector of the destination literals, or NULL
+            count: the number of implications in the list, incremented
+            source: the literal implying the destination
+            destination: the literal implied
+    */
+
+    if (from != NULL) {
+        from[*count] = source;
+        to[*count] = destination;
+    }
+    (*count)++;
+}
+
+void build_implication_graph(Board board, int **edge_offsets, int **edges) {
+
+    /*
+        This function is responsible for building the implication graph in compressed form: the successors of the literal l
+        are edges[edge_offsets[l]] ... edges[edge_offsets[l + 1] - 1].
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            edge_offsets: the vector of the offsets of the successors of each literal, allocated with 2 * cells + 1 entries
+            edges: the vector of the successors, allocated
+    */
+
+    int i, literals_count = 2 * board.rows_count * board.cols_count;
+    int implications_count = collect_implications(board, NULL, NULL);
+
+    int *from = (int *) malloc(implications_count * sizeof(int));
+    int *to = (int *) malloc(implications_count * sizeof(int));
+    collect_implications(board, from, to);
+
+    *edge_offsets = (int *) calloc(literals_count + 1, sizeof(int));
+    *edges = (int *) malloc(implications_count * sizeof(int));
+
+    for (i = 0; i < implications_count; i++)
+        (*edge_offsets)[from[i] + 1]++;
+    for (i = 0; i < literals_count; i++)
+        (*edge_offsets)[i + 1] += (*edge_offsets)[i];
+
+    int *fill = (int *) malloc(literals_count * sizeof(int));
+    memcpy(fill, *edge_offsets, literals_count * sizeof(int));
+    for (i = 0; i < implications_count; i++)
+        (*edges)[fill[from[i]]++] = to[i];
+
+    free(fill);
+    free(from);
+    free(to);
+}
+
+int compute_components(int literals_count, int *edge_offsets, int *edges, int *component) {
+
+    /*
+        This function is responsible for computing the strongly connected components of the implication graph with Tarjan's algorithm,
+        made iterative with an explicit call stack so that large boards do not overflow the stack.
+        The components are numbered in the order they are completed, which is a reverse topological order of the condensed graph.
+        It returns the number of components.
+    */
+
+    /*
+        Parameters:
+            literals_count: the number of literals of the graph
+            edge_offsets: the offsets of the successors of each literal
+            edges: the successors
+            component: the vector filled with the component of each literal
+    */
+
+    int *index = (int *) malloc(literals_count * sizeof(int));
+    int *lowlink = (int *) malloc(literals_count * sizeof(int));
+    bool *on_stack = (bool *) calloc(literals_count, sizeof(bool));
+    int *stack = (int *) malloc(literals_count * sizeof(int));
+    int *call_stack = (int *) malloc(literals_count * sizeof(int));
+    int *call_edge = (int *) malloc(literals_count * sizeof(int));
+    memset(index, -1, literals_count * sizeof(int));
+
+    int root, literal, successor, parent, stack_size = 0, depth = 0, next_index = 0, components_count = 0;
+
+    for (root = 0; root < literals_count; root++) {
+        if (index[root] != -1) continue;
+
+        index[root] = lowlink[root] = next_index++;
+        stack[stack_size++] = root;
+        on_stack[root] = true;
+        call_stack[depth] = root;
+        call_edge[depth++] = edge_offsets[root];
+
+        while (depth > 0) {
+            literal = call_stack[depth - 1];
+
+            if (call_edge[depth - 1] < edge_offsets[literal + 1]) {
+                successor = edges[call_edge[depth - 1]++];
+                if (index[successor] == -1) {
+                    index[successor] = lowlink[successor] = next_index++;
+                    stack[stack_size++] = successor;
+                    on_stack[successor] = true;
+                    call_stack[depth] = successor;
+                    call_edge[depth++] = edge_offsets[successor];
+                } else if (on_stack[successor] && index[successor] < lowlink[literal])
+                    lowlink[literal] = index[successor];
+                continue;
+            }
+
+            // All the successors are visited, the literal closes a component if it is its root
+            if (lowlink[literal] == index[literal]) {
+                do {
+                    successor = stack[--stack_size];
+                    on_stack[successor] = false;
+                    component[successor] = components_count;
+                } while (successor != literal);
+                components_count++;
+            }
+
+            depth--;
+            if (depth > 0) {
+                parent = call_stack[depth - 1];
+                if (lowlink[literal] < lowlink[parent])
+                    lowlink[parent] = lowlink[literal];
+            }
+        }
+    }
+
+    free(index);
+    free(lowlink);
+    free(on_stack);
+    free(stack);
+    free(call_stack);
+    free(call_edge);
+
+    return components_count;
+}
@@ -7,8 +7,9 @@
 
 void read_board(Board* board, char *filename);
 void print_board(char *title, Board board, BoardType type);
-bool is_board_solution_equal(Board first_board, Board second_board);
 Board transpose(Board board);
-Board combine_boards(Board first_board, Board second_board, bool forced, int rank, char *technique, MPI_Comm PRUNING_COMM);
+int merge_solutions(int *solution, int *partial, int cells_count, bool forced);
+void mpi_merge_solutions(int *solution, int *partial, int cells_count, bool forced, int rank, char *technique, MPI_Comm PRUNING_COMM);
+Board mpi_merge_lines(Board board, int *row_solution, int *col_solution, bool forced, int rank, char *technique, MPI_Comm PRUNING_COMM);
 
 #endif
\ No newline at end of file
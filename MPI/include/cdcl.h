@@ -0,0 +1,33 @@
+#ifndef CDCL_H
+#define CDCL_H
+
+#include "common.h"
+#include "two_sat.h"
+
+// Accessors of the literals, BLACK_LITERAL(cell) is true when the cell is black and WHITE_LITERAL(cell) when it is white
+#define LITERAL_CELL(literal) ((literal) >> 1)
+#define LITERAL_STATE(literal) ((literal) & 1 ? WHITE : BLACK)
+#define NEGATE_LITERAL(literal) ((literal) ^ 1)
+#define IS_LITERAL_TRUE(values, literal) ((values)[LITERAL_CELL(literal)] == LITERAL_STATE(literal))
+#define IS_LITERAL_FALSE(values, literal) ((values)[LITERAL_CELL(literal)] == LITERAL_STATE(NEGATE_LITERAL(literal)))
+
+void init_cdcl_solver(Board board, CdclSolver *solver, unsigned int seed);
+void free_cdcl_solver(CdclSolver *solver);
+int add_cdcl_clause(CdclSolver *solver, int *literals, int literals_count, int lbd);
+void add_watch(CdclSolver *solver, int literal, int clause);
+void assign_literal(CdclSolver *solver, int literal, int reason);
+int propagate_cdcl(CdclSolver *solver);
+int find_white_cut(Board board, CdclSolver *solver);
+int flood_white_region(Board board, CdclSolver *solver, int seed, int *cut, int *cut_count);
+bool resolve_conflict(CdclSolver *solver, int conflict);
+int analyze_conflict(CdclSolver *solver, int conflict, int *learned_count);
+int compute_lbd(CdclSolver *solver, int *literals, int literals_count);
+void backtrack_cdcl(CdclSolver *solver, int level);
+void bump_activity(CdclSolver *solver, int cell);
+int pick_branch_cell(CdclSolver *solver);
+void reduce_learned_clauses(CdclSolver *solver);
+long long luby_sequence(int index);
+CdclResult search_cdcl(Board board, CdclSolver *solver, long long max_conflicts);
+void cdcl_to_solution(Board board, CdclSolver *solver, CellState *solution);
+
+#endif
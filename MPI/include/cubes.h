@@ -0,0 +1,11 @@
+#ifndef CUBES_H
+#define CUBES_H
+
+#include "common.h"
+
+int generate_cubes(Board board, int target_count, Cube **cubes);
+int select_cube_cell(Board board, BCB *block, Cube *cube, int *white_fixed, int *black_fixed);
+bool apply_cube(Board board, BCB *block, int *literals, int literals_count);
+int compare_cubes(const void *first, const void *second);
+
+#endif
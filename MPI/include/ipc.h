@@ -5,8 +5,10 @@
 
 #include "common.h"
 
-void block_to_buffer(BCB* block, int **buffer);
-bool buffer_to_block(int *buffer, BCB *block);
+int block_to_buffer(BCB* block, uint64_t **buffer);
+bool buffer_to_block(uint64_t *buffer, BCB *block);
+uint64_t pack_decision(Decision *decision);
+void unpack_decision(uint64_t word, Decision *decision);
 void receive_message(Message *message, int source, MPI_Request *request, int tag);
 void send_message(int destination, MPI_Request *request, MessageType type, int data1, int data2, bool invalid, int tag);
 void init_requests_and_messages();
@@ -16,5 +18,10 @@ void worker_check_messages();
 void manager_consume_message(Message *message, int source);
 void manager_check_messages(); 
 void wait_for_message(MPI_Request *request);
+void init_nogood_exchange();
+void share_nogoods(BCB *block);
+void receive_nogoods(BCB *block);
+void import_received_nogoods(BCB *block);
+void finish_nogood_exchange();
 
 #endif
\ No newline at end of file
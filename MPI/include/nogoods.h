@@ -0,0 +1,27 @@
+#ifndef NOGOODS_H
+#define NOGOODS_H
+
+#include "common.h"
+#include "bitboard.h"
+
+// Number of words of the levels of a conflict, and of a whole conflict: the levels followed by the cells assumed by the block
+#define LEVEL_WORDS(cells_count) WORDS_PER_ROW((cells_count) + 1)
+#define CONFLICT_WORDS(cells_count) (LEVEL_WORDS(cells_count) + WORDS_PER_ROW(cells_count))
+
+void init_nogood_store(NogoodStore *store);
+void copy_nogood_store(NogoodStore *destination, NogoodStore *source);
+void free_nogood_store(NogoodStore *store);
+void add_conflict_level(Board board, BCB *block, int cell_index);
+void add_chain_levels(Board board, BCB *block, int root);
+void set_earlier_levels(Board board, uint64_t *levels, int level);
+void explain_conflict(Board board, BCB *block);
+void explain_leaf_conflict(Board board, BCB *block);
+void explain_nogood(Board board, BCB *block, int nogood_index);
+bool backjump(Board board, BCB *block);
+void record_nogood(Board board, BCB *block);
+void store_nogood(NogoodStore *store, int *literals, int length, bool local, bool exported);
+int find_violated_nogood(Board board, BCB *block);
+CellState decision_state(Decision *decision);
+void compute_decision_levels(Board board, BCB *block);
+
+#endif
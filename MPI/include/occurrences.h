@@ -0,0 +1,11 @@
+#ifndef OCCURRENCES_H
+#define OCCURRENCES_H
+
+#include "common.h"
+
+ValueOccurrences *build_value_occurrences(Board board);
+int row_occurrences(Board board, int row, int value, const int **cols);
+int col_occurrences(Board board, int col, int value, const int **rows);
+void free_value_occurrences(ValueOccurrences *occurrences);
+
+#endif
@@ -6,12 +6,15 @@
 #include "common.h" 
 
 Board mpi_uniqueness_rule(Board board, int rank, int size, MPI_Comm PRUNING_COMM);
-Board mpi_set_white(Board board, int rank, int size, MPI_Comm PRUNING_COMM);
-Board mpi_set_black(Board board, int rank, int size, MPI_Comm PRUNING_COMM);
 Board mpi_sandwich_rules(Board board, int rank, int size, MPI_Comm PRUNING_COMM);
+int match_line_patterns(int *lines, int *solution, int lines_count, int length, PatternRule *rules, int rules_count);
 Board mpi_pair_isolation(Board board, int rank, int size, MPI_Comm PRUNING_COMM);
 void compute_corner(Board board, int x, int y, CornerType corner_type, int **local_corner_solution);
 Board mpi_corner_cases(Board board, int rank, int size, MPI_Comm PRUNING_COMM);
 Board mpi_flanked_isolation(Board board, int rank, int size, MPI_Comm PRUNING_COMM);
+Board mpi_two_sat_rule(Board board, int rank, int size, MPI_Comm PRUNING_COMM);
+Board mpi_articulation_point_rule(Board board, int rank, int size, MPI_Comm PRUNING_COMM);
+Board mpi_fixed_point_propagation(Board board, int rank, int size, MPI_Comm PRUNING_COMM);
+Board mpi_failed_literal_probing(Board board, int rank, int size, MPI_Comm PROBING_COMM);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef ROW_PATTERNS_H
+#define ROW_PATTERNS_H
+
+#include "common.h"
+
+#define ROW_PATTERNS_MAX_COLS 32
+#define ROW_FULL_MASK(cols) ((cols) == 32 ? 0xFFFFFFFFu : ((1u << (cols)) - 1))
+
+// Two rows are compatible when their same-value columns have at least one black cell, and adjacent rows have no black cells on top of each other
+#define ROWS_COMPATIBLE(black1, black2, same, adjacent) ((~((black1) | (black2)) & (same)) == 0 && (!(adjacent) || ((black1) & (black2)) == 0))
+
+bool build_row_patterns(Board board, RowPatterns *patterns);
+bool enumerate_row_masks(Board board, RowPatterns *patterns, int row, int col, uint32_t mask, bool *white_values, int *capacity);
+void filter_row_patterns(Board board, RowPatterns *patterns);
+bool has_row_support(Board board, RowPatterns *patterns, uint32_t mask, int row, int other_row);
+void free_row_patterns(RowPatterns *patterns);
+void init_row_search(Board board, RowPatterns *patterns, RowSearch *search, int first_mask, int stride);
+void free_row_search(RowSearch *search);
+RowSearchResult search_row_patterns(Board board, RowPatterns *patterns, RowSearch *search, long long max_nodes);
+bool filter_row_domains(Board board, RowPatterns *patterns, RowSearch *search, int row, uint32_t mask);
+bool are_row_whites_connected(Board board, RowSearch *search, int last_row);
+uint32_t expand_row_whites(uint32_t seed, uint32_t whites);
+void row_search_to_solution(Board board, RowSearch *search, CellState *solution);
+
+#endif
@@ -9,6 +9,10 @@ void write_solution(Board board);
 void print_vector(int *vector, int size);
 void print_block(Board board, char *title, BCB* block);
 void free_memory(int *pointers[]);
+SolverConfig read_config(int argc, char **argv);
+SolverConfig portfolio_config(SolverConfig config, int group);
+int portfolio_groups_count(int members);
+int portfolio_group_size(int members, int group);
 void mpi_share_board(Board* board, int rank);
 void mpi_scatter_board(Board board, int rank, int size, ScatterType scatter_type, BoardType target_type, int **local_vector, int **counts_send, int **displs_send, MPI_Comm PRUNING_COMM);
 void mpi_gather_board(Board board, int rank, int *local_vector, int *counts_send, int *displs_send, int **solution, MPI_Comm PRUNING_COMM);
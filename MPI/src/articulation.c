@@ -0,0 +1,107 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/articulation.h"
+
+/*
+    Articulation points of the graph of the non-black cells, where each cell is linked to its orthogonal neighbours.
+    A cell is an articulation point when removing it splits the component it belongs to: blackening it would split the white cells,
+    so an unknown articulation point must be white.
+*/
+
+void find_articulation_points(Board board, bool *articulation) {
+
+    /*
+        This function is responsible for finding the articulation points of the non-black cells with Tarjan's algorithm,
+        made iterative with an explicit call stack so that large boards do not overflow the stack.
+        The root of a depth-first tree is an articulation point when it has more than one child, any other cell when one of its children
+        cannot reach a cell visited before it without passing through it.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved, with the cells already known
+            articulation: the vector filled with a flag for each cell, set on the articulation points
+    */
+
+    int cells_count = board.rows_count * board.cols_count;
+    int *index = (int *) malloc(cells_count * sizeof(int));
+    int *lowlink = (int *) malloc(cells_count * sizeof(int));
+    int *parent = (int *) malloc(cells_count * sizeof(int));
+    int *call_stack = (int *) malloc(cells_count * sizeof(int));
+    int *call_direction = (int *) malloc(cells_count * sizeof(int));
+    memset(index, -1, cells_count * sizeof(int));
+    memset(articulation, 0, cells_count * sizeof(bool));
+
+    int root, cell_index, neighbour, previous, root_children, depth, next_index = 0;
+
+    for (root = 0; root < cells_count; root++) {
+        if (board.solution[root] == BLACK || index[root] != -1) continue;
+
+        index[root] = lowlink[root] = next_index++;
+        parent[root] = -1;
+        root_children = 0;
+        call_stack[0] = root;
+        call_direction[0] = 0;
+        depth = 1;
+
+        while (depth > 0) {
+            cell_index = call_stack[depth - 1];
+
+            if (call_direction[depth - 1] < 4) {
+                neighbour = grid_neighbour(board, cell_index, call_direction[depth - 1]++);
+                if (neighbour == -1 || board.solution[neighbour] == BLACK) continue;
+
+                if (index[neighbour] == -1) {
+                    index[neighbour] = lowlink[neighbour] = next_index++;
+                    parent[neighbour] = cell_index;
+                    if (cell_index == root) root_children++;
+                    call_stack[depth] = neighbour;
+                    call_direction[depth++] = 0;
+                } else if (neighbour != parent[cell_index] && index[neighbour] < lowlink[cell_index])
+                    lowlink[cell_index] = index[neighbour];
+                continue;
+            }
+
+            // All the neighbours are visited, the parent is an articulation point if the cell cannot reach above it
+            depth--;
+            if (depth > 0) {
+                previous = call_stack[depth - 1];
+                if (lowlink[cell_index] < lowlink[previous])
+                    lowlink[previous] = lowlink[cell_index];
+                if (previous != root && lowlink[cell_index] >= index[previous])
+                    articulation[previous] = true;
+            }
+        }
+
+        if (root_children > 1) articulation[root] = true;
+    }
+
+    free(index);
+    free(lowlink);
+    free(parent);
+    free(call_stack);
+    free(call_direction);
+}
+
+int grid_neighbour(Board board, int cell_index, int direction) {
+
+    /*
+        This function is responsible for finding the orthogonal neighbour of a cell in one of the four directions: up, down, left, right.
+        It returns the index of the neighbour, -1 if it is outside the board.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            cell_index: the index of the cell in the board
+            direction: the direction of the neighbour, from 0 to 3
+    */
+
+    int x = cell_index / board.cols_count, y = cell_index % board.cols_count;
+
+    if (direction == 0) return x > 0 ? cell_index - board.cols_count : -1;
+    if (direction == 1) return x < board.rows_count - 1 ? cell_index + board.cols_count : -1;
+    if (direction == 2) return y > 0 ? cell_index - 1 : -1;
+    return y < board.cols_count - 1 ? cell_index + 1 : -1;
+}
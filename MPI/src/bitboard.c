@@ -0,0 +1,59 @@
+#include "../include/bitboard.h"
+
+int count_bits(const uint64_t *rows, int words_count) {
+
+    /*
+        Helper function to count the cells set in a sequence of bit rows.
+    */
+
+    /*
+        Parameters:
+            rows: the bit rows to be counted
+            words_count: the total number of words of the bit rows
+    */
+
+    int i, count = 0;
+    for (i = 0; i < words_count; i++)
+        count += __builtin_popcountll(rows[i]);
+    return count;
+}
+
+int find_first_bit(const uint64_t *rows, int words_count) {
+
+    /*
+        Helper function to find the position of the first cell set in a sequence of bit rows.
+        The position is expressed in bits from the start of the rows, -1 is returned if no cell is set.
+    */
+
+    /*
+        Parameters:
+            rows: the bit rows to be searched
+            words_count: the total number of words of the bit rows
+    */
+
+    int i;
+    for (i = 0; i < words_count; i++)
+        if (rows[i] != 0)
+            return i * BITS_PER_WORD + __builtin_ctzll(rows[i]);
+    return -1;
+}
+
+int find_last_bit(const uint64_t *rows, int words_count) {
+
+    /*
+        Helper function to find the position of the last cell set in a sequence of bit rows.
+        The position is expressed in bits from the start of the rows, -1 is returned if no cell is set.
+    */
+
+    /*
+        Parameters:
+            rows: the bit rows to be searched
+            words_count: the total number of words of the bit rows
+    */
+
+    int i;
+    for (i = words_count - 1; i >= 0; i--)
+        if (rows[i] != 0)
+            return i * BITS_PER_WORD + BITS_PER_WORD - 1 - __builtin_clzll(rows[i]);
+    return -1;
+}
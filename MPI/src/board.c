@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "../include/board.h"
+#include "../include/occurrences.h"
 
 void read_board(Board* board, char *filename) {
 
@@ -67,6 +68,12 @@ void read_board(Board* board, char *filename) {
         do {  
             board->grid[temp_row * cols + temp_col] = atoi(token);
             board->solution[temp_row * cols + temp_col] = UNKNOWN;
+
+            // The white counters of the blocks are indexed by value, so the values must be in the range [1, cols]
+            if (board->grid[temp_row * cols + temp_col] < 1 || board->grid[temp_row * cols + temp_col] > cols) {
+                printf("The board values must be between 1 and %d.\n", cols);
+                MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+            }
             temp_col++;
         } while ((token = strtok(NULL, " ")));
 
@@ -74,6 +81,8 @@ void read_board(Board* board, char *filename) {
     }
 
     fclose(fp);
+
+    board->occurrences = build_value_occurrences(*board);
 } 
 
 void print_board(char *title, Board board, BoardType type) {
@@ -111,121 +120,140 @@ void print_board(char *title, Board board, BoardType type) {
     printf("%s", buffer);
 }
 
-bool is_board_solution_equal(Board first_board, Board second_board) {
+Board transpose(Board board) {
     /*
-        Helper function to check if two boards are equal.
+        Helper function to transpose a board. The transposed board only lays out the columns as rows, it has no occurrences.
     */
 
     /*
         Parameters:
-            - first_board: the first board to be compared
-            - second_board: the second board to be compared
+            - board: the board to be transposed
     */
 
-    if (first_board.rows_count != second_board.rows_count || first_board.cols_count != second_board.cols_count) return false;
+    Board Tboard = { (int *) malloc(board.rows_count * board.cols_count * sizeof(int)), board.cols_count, board.rows_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)), NULL };
 
     int i, j;
-    for (i = 0; i < first_board.rows_count; i++)
-        for (j = 0; j < first_board.cols_count; j++)
-            if (first_board.solution[i * first_board.cols_count + j] != second_board.solution[i * first_board.cols_count + j]) return false;
+    for (i = 0; i < board.rows_count; i++) {
+        for (j = 0; j < board.cols_count; j++) {
+            Tboard.grid[j * board.rows_count + i] = board.grid[i * board.cols_count + j];
+            Tboard.solution[j * board.rows_count + i] = board.solution[i * board.cols_count + j];
+        }
+    }
 
-    return true;
+    return Tboard;
 }
 
-Board transpose(Board board) {
+int merge_solutions(int *solution, int *partial, int cells_count, bool forced) {
+
     /*
-        Helper function to transpose a board.
+        Helper function to merge a partial solution into the working solution, in place.
     */
 
     /*
         Parameters:
-            - board: the board to be transposed
+            - solution: the working solution, overwritten with the merged cells
+            - partial: the partial solution to be merged
+            - cells_count: the number of cells of the board
+            - forced: if the technique is forced, the values must be the same
+
+        Returns the number of cells where one solution is WHITE and the other one is BLACK.
     */
 
-    Board Tboard = { (int *) malloc(board.rows_count * board.cols_count * sizeof(int)), board.cols_count, board.rows_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)) };
+    int i, conflicts = 0;
 
-    int i, j;
-    for (i = 0; i < board.rows_count; i++) {
-        for (j = 0; j < board.cols_count; j++) {
-            Tboard.grid[j * board.rows_count + i] = board.grid[i * board.cols_count + j];
-            Tboard.solution[j * board.rows_count + i] = board.solution[i * board.cols_count + j];
+    /*
+        Merge the solutions by performing a branchless pairwise comparison:
+            1) If the values are the same, keep the value
+            2) If only one value is unknown, keep the known value (UNKNOWN is the smallest state, so the maximum)
+            3) If the values are WHITE and BLACK, their sum is 1: count the conflict and leave the cell as unknown
+
+        Forced techniques must require the values to be the same.
+    */
+
+    if (forced) {
+        for (i = 0; i < cells_count; i++) {
+            int first = solution[i], second = partial[i];
+            conflicts += (first + second == 1);
+            solution[i] = first == second ? first : UNKNOWN;
+        }
+    } else {
+        for (i = 0; i < cells_count; i++) {
+            int first = solution[i], second = partial[i];
+            int conflict = (first + second == 1);
+            conflicts += conflict;
+            solution[i] = (first > second ? first : second) - 2 * conflict;
         }
     }
 
-    return Tboard;
+    return conflicts;
 }
 
-Board combine_boards(Board first_board, Board second_board, bool forced, int rank, char *technique, MPI_Comm PRUNING_COMM) {
-    
+void mpi_merge_solutions(int *solution, int *partial, int cells_count, bool forced, int rank, char *technique, MPI_Comm PRUNING_COMM) {
+
     /*
-        Helper function to combine two boards.
+        Helper function to merge a partial solution into the working solution on the manager, and share the merged solution.
     */
 
     /*
         Parameters:
-            - first_board: the first board to be combined
-            - second_board: the second board to be combined
+            - solution: the working solution, overwritten with the merged cells on every pruning worker
+            - partial: the partial solution to be merged, only read by the manager
+            - cells_count: the number of cells of the board
             - forced: if the technique is forced, the values must be the same
             - rank: the rank of the process
             - technique: the name of the technique
             - PRUNING_COMM: the MPI communicator dedicated to the pruning workers
     */
 
-    int rows = -1, cols = -1;
+    int conflicts = 0;
 
-    if (rank == MANAGER_RANK) {
-        rows = first_board.rows_count;
-        cols = first_board.cols_count;
+    if (rank == MANAGER_RANK) conflicts = merge_solutions(solution, partial, cells_count, forced);
+
+    MPI_Bcast(&conflicts, 1, MPI_INT, MANAGER_RANK, PRUNING_COMM);
+    if (conflicts > 0) {
+        if (rank == MANAGER_RANK) printf("[ERROR] The board has no solution, %d cells of the %s are both white and black\n", conflicts, technique);
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
     }
 
     /*
-        Broadcast the dimensions of the boards.
+        The pruning workers already share the grid and its dimensions, only the merged solution is broadcast.
     */
 
-    MPI_Bcast(&rows, 1, MPI_INT, MANAGER_RANK, PRUNING_COMM);
-    MPI_Bcast(&cols, 1, MPI_INT, MANAGER_RANK, PRUNING_COMM);
+    MPI_Bcast(solution, cells_count, MPI_INT, MANAGER_RANK, PRUNING_COMM);
+}
+
+Board mpi_merge_lines(Board board, int *row_solution, int *col_solution, bool forced, int rank, char *technique, MPI_Comm PRUNING_COMM) {
 
     /*
-        Initialize the solution board with the values of the original board.
+        Helper function to merge the column-wise partial solution of a technique into its row-wise partial solution, in place.
     */
 
-    Board merged = { (int *) malloc(rows * cols * sizeof(int)), rows, cols, (int *) malloc(rows * cols * sizeof(int)) };
-
-    if (rank == MANAGER_RANK) merged.grid = first_board.grid;
-
-    MPI_Bcast(merged.grid, rows * cols, MPI_INT, MANAGER_RANK, PRUNING_COMM);
-
     /*
-        Combine the solutions by performing a pairwise comparison:
-            1) If the values are the same, keep the value
-            2) If only one value is unknown, keep the known value
-            3) If the values are different, leave the cell as unknown
-        
-        Forced techniques must require the values to be the same.
+        Parameters:
+            - board: the board the technique was applied to
+            - row_solution: the row-wise partial solution, overwritten with the merged cells on every pruning worker
+            - col_solution: the column-wise partial solution, stored column by column and only read by the manager
+            - forced: if the technique is forced, the values must be the same
+            - rank: the rank of the process
+            - technique: the name of the technique
+            - PRUNING_COMM: the MPI communicator dedicated to the pruning workers
     */
 
-    if (rank == MANAGER_RANK) {
+    int cells_count = board.rows_count * board.cols_count;
+    int *transposed = NULL;
 
-        memset(merged.solution, UNKNOWN, rows * cols * sizeof(int));
+    if (rank == MANAGER_RANK) {
+        transposed = (int *) malloc(cells_count * sizeof(int));
 
         int i, j;
-        for (i = 0; i < rows; i++) {
-            for (j = 0; j < cols; j++) {
-                if (first_board.solution[i * cols + j] == second_board.solution[i * cols + j]) 
-                    merged.solution[i * cols + j] = first_board.solution[i * cols + j];
-                else if (!forced && first_board.solution[i * cols + j] == UNKNOWN && second_board.solution[i * cols + j] != UNKNOWN) 
-                    merged.solution[i * cols + j] = second_board.solution[i * cols + j];
-                else if (!forced && first_board.solution[i * cols + j] != UNKNOWN && second_board.solution[i * cols + j] == UNKNOWN) 
-                    merged.solution[i * cols + j] = first_board.solution[i * cols + j];
-            }   
-        }
+        for (i = 0; i < board.rows_count; i++)
+            for (j = 0; j < board.cols_count; j++)
+                transposed[i * board.cols_count + j] = col_solution[j * board.rows_count + i];
     }
 
-    /*
-        Broadcast the merged solution.
-    */
-    
-    MPI_Bcast(merged.solution, rows * cols, MPI_INT, MANAGER_RANK, PRUNING_COMM);
+    mpi_merge_solutions(row_solution, transposed, cells_count, forced, rank, technique, PRUNING_COMM);
+
+    if (rank == MANAGER_RANK) free(transposed);
 
-    return merged;
+    return (Board) { board.grid, board.rows_count, board.cols_count, row_solution, board.occurrences };
 }
@@ -0,0 +1,193 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/cubes.h"
+#include "../include/backtracking.h"
+#include "../include/probing.h"
+
+/*
+    Cube split of the backtracking search: the manager splits the pruned board into cubes, partial assignments that together cover every solution,
+    then the processes pull them one at a time. The cube with the most unknown cells left is split first, on the cell chosen by a lookahead:
+    both states of each unknown cell are propagated and the cell fixing the most cells on both sides is chosen, so that the cubes shrink evenly.
+    The states leading to a conflict are dropped, which fixes the cell in the cube, or removes the cube when both states fail.
+*/
+
+int generate_cubes(Board board, int target_count, Cube **cubes) {
+
+    /*
+        This function is responsible for splitting the board into at most target_count cubes, sorted by decreasing number of unknown cells
+        so that the hardest ones are handed out first. It stops earlier when no cube has unknown cells left.
+        It returns the number of cubes, 0 if the board has no solution.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved, with the pruned solution
+            target_count: the maximum number of cubes
+            cubes: the vector of the cubes, allocated
+    */
+
+    int i, cube_index, cell_index, white_fixed, black_fixed, remaining;
+    int cells_count = board.rows_count * board.cols_count;
+
+    *cubes = (Cube *) malloc(target_count * sizeof(Cube));
+
+    (*cubes)[0].literals = (int *) malloc(cells_count * sizeof(int));
+    (*cubes)[0].literals_count = 0;
+    (*cubes)[0].unknowns = 0;
+    for (i = 0; i < cells_count; i++)
+        if (board.solution[i] == UNKNOWN)
+            (*cubes)[0].unknowns++;
+
+    int cubes_count = 1;
+    while (cubes_count < target_count) {
+
+        // Pick the cube with the most unknown cells left
+        cube_index = 0;
+        for (i = 1; i < cubes_count; i++)
+            if ((*cubes)[i].unknowns > (*cubes)[cube_index].unknowns)
+                cube_index = i;
+        if ((*cubes)[cube_index].unknowns == 0) break;
+
+        Cube *cube = &(*cubes)[cube_index];
+        BCB block;
+        init_probe_block(board, &block);
+        apply_cube(board, &block, cube->literals, cube->literals_count);
+        cell_index = select_cube_cell(board, &block, cube, &white_fixed, &black_fixed);
+
+        remaining = 0;
+        for (i = 0; i < cells_count; i++)
+            if (block.solution[i] == UNKNOWN)
+                remaining++;
+        free_block(&block);
+
+        if (cell_index == -2) {
+            // Both states of a cell fail, the cube has no solution and is replaced by the last one
+            free(cube->literals);
+            (*cubes)[cube_index] = (*cubes)[--cubes_count];
+            if (cubes_count == 0) break;
+            continue;
+        }
+        if (cell_index == -1) {
+            cube->unknowns = 0;
+            continue;
+        }
+
+        // Split the cube on the selected cell, the white side stays in place and the black one is appended
+        Cube *black_cube = &(*cubes)[cubes_count++];
+        black_cube->literals = (int *) malloc(cells_count * sizeof(int));
+        memcpy(black_cube->literals, cube->literals, cube->literals_count * sizeof(int));
+        black_cube->literals_count = cube->literals_count;
+        black_cube->literals[black_cube->literals_count++] = 2 * cell_index + BLACK;
+        black_cube->unknowns = remaining - black_fixed;
+
+        cube->literals[cube->literals_count++] = 2 * cell_index + WHITE;
+        cube->unknowns = remaining - white_fixed;
+    }
+
+    qsort(*cubes, cubes_count, sizeof(Cube), compare_cubes);
+    return cubes_count;
+}
+
+int select_cube_cell(Board board, BCB *block, Cube *cube, int *white_fixed, int *black_fixed) {
+
+    /*
+        This function is responsible for the lookahead on the unknown cells of a cube: both states of each cell are propagated on the block,
+        and the cell with the highest product of the cells fixed by the two states is selected.
+        A state leading to a conflict fixes the cell to the other one, on the block and in the cube, and the lookahead is repeated.
+        It returns the index of the selected cell, -1 if no cell is unknown, or -2 if both states of a cell fail.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB with the cube applied
+            cube: the cube to split, the fixed cells are appended to its literals
+            white_fixed: the number of cells fixed by the white state of the selected cell, including itself
+            black_fixed: the number of cells fixed by the black state of the selected cell, including itself
+    */
+
+    int cell_index, best_cell, white_count, black_count, trail_mark;
+    long long score, best_score;
+    bool white_valid, black_valid, forced = true;
+
+    while (forced) {
+        forced = false;
+        best_cell = -1;
+        best_score = -1;
+
+        for (cell_index = 0; cell_index < board.rows_count * board.cols_count; cell_index++) {
+            if (block->solution[cell_index] != UNKNOWN) continue;
+            trail_mark = block->trail_size;
+
+            white_valid = try_probe_state(board, block, cell_index, WHITE);
+            white_count = block->trail_size - trail_mark;
+            undo_trail(board, block, trail_mark);
+
+            black_valid = try_probe_state(board, block, cell_index, BLACK);
+            black_count = block->trail_size - trail_mark;
+
+            if (!white_valid && !black_valid) return -2;
+            if (!white_valid || !black_valid) {
+                // Keep the only valid state, already on the block when it is the black one
+                if (!black_valid) try_probe_state(board, block, cell_index, WHITE);
+                cube->literals[cube->literals_count++] = 2 * cell_index + (black_valid ? BLACK : WHITE);
+                forced = true;
+                continue;
+            }
+            undo_trail(board, block, trail_mark);
+
+            score = (long long) white_count * black_count;
+            if (score > best_score) {
+                best_score = score;
+                best_cell = cell_index;
+                *white_fixed = white_count;
+                *black_fixed = black_count;
+            }
+        }
+    }
+    return best_cell;
+}
+
+bool apply_cube(Board board, BCB *block, int *literals, int literals_count) {
+
+    /*
+        This function is responsible for assigning the cells of a cube to a block and propagating them.
+        The assignments are not decisions, so the search on the block never undoes them.
+        It returns false if the cube leads to a conflict.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update
+            literals: the cells of the cube, as 2 * cell + state
+            literals_count: the number of cells of the cube
+    */
+
+    int i, cell_index, trail_mark;
+    for (i = 0; i < literals_count; i++) {
+        cell_index = literals[i] / 2;
+        trail_mark = block->trail_size;
+        if (!force_cell(board, block, cell_index / board.cols_count, cell_index % board.cols_count, literals[i] % 2 == BLACK ? BLACK : WHITE))
+            return false;
+        if (!propagate(board, block, trail_mark))
+            return false;
+    }
+    return true;
+}
+
+int compare_cubes(const void *first, const void *second) {
+
+    /*
+        This function is responsible for ordering the cubes by decreasing number of unknown cells, as a qsort comparator.
+    */
+
+    /*
+        Parameters:
+            first: the first cube
+            second: the second cube
+    */
+
+    return ((const Cube *) second)->unknowns - ((const Cube *) first)->unknowns;
+}
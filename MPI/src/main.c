@@ -14,6 +14,13 @@
 #include "../include/validation.h"
 #include "../include/backtracking.h"
 #include "../include/ipc.h"
+#include "../include/bitboard.h"
+#include "../include/row_patterns.h"
+#include "../include/cdcl.h"
+#include "../include/cubes.h"
+#include "../include/probing.h"
+#include "../include/nogoods.h"
+#include "../include/frontier.h"
 
 /* ------------------ GLOBAL VARIABLES ------------------ */
 Board board;
@@ -30,6 +37,34 @@ bool is_my_solution_spaces_ended = false;
 int solutions_to_skip = 0;
 int total_processes_in_solution_space = 1;
 int *unknown_index, *unknown_index_length, *processes_in_my_solution_space;
+long long nodes_explored = 0;
+SolverConfig config;
+
+// ----- Row patterns variables -----
+RowPatterns row_patterns;
+
+// ----- Cube split variables -----
+Cube *cubes;                    // Cubes generated by the manager, the hardest first
+int cubes_count = 0;            // Number of cubes generated by the manager
+int next_cube = 0;              // Index of the next cube to hand out
+int cube_winner = -1;           // Rank of the process whose solution is kept, -1 if none
+int done_workers = 0;           // Number of workers that received the termination
+bool *cube_terminated_workers;  // Flags of the workers the manager sent the termination to
+int *cube_buffer;               // Buffer of the cube messages, the number of cells followed by the cells
+
+// ----- Nogood exchange variables -----
+NogoodStore received_nogoods;       // Nogoods received from the other processes, imported in each new block
+int *nogood_send_buffer;            // Buffer of the nogoods sent, the number of nogoods followed by the length and the cells of each one
+int *nogood_receive_buffer;         // Buffer of the nogoods received, in the same format
+int nogood_buffer_size;             // Maximum number of integers of a nogood message
+MPI_Request *nogood_send_requests;  // Requests of the last batch of nogoods sent to each process
+int *nogood_sent_counts;            // Number of nogood messages sent to each process
+int *nogood_received_counts;        // Number of nogood messages received from each process
+long long nogoods_shared = 0;       // Number of nogoods sent by the process
+
+// ----- Portfolio variables -----
+int portfolio_groups;           // Number of groups of the portfolio, each one searching the whole board with its own configuration
+int *portfolio_exhausted;       // Number of members of each group that searched their share without a solution, kept by the manager
 
 // ----- Worker variables -----
 Message messagesqueue[MAX_MSG_SIZE];
@@ -38,7 +73,9 @@ int message_index = 0;
 Message manager_message, receive_work_message, refresh_solution_space_message, finished_solution_space_message;
 MPI_Request manager_request;   // Request for the workers to contact the manager
 MPI_Request receive_work_request, refresh_solution_space_request; // dedicated worker-worker
-int *receive_work_buffer, *send_work_buffer;
+uint64_t *receive_work_buffer, *send_work_buffer;
+int block_buffer_size;          // Maximum number of words of a block transferred between workers
+int send_work_buffer_size;      // Number of words of the block in the send buffer
 
 // ----- Manager variables -----
 Message *worker_messages;
@@ -47,37 +84,120 @@ WorkerStatus *worker_statuses;  // Status of each worker
 
 /* ------------------ FUNCTION DECLARATIONS ------------------ */
 
-void block_to_buffer(BCB* block, int **buffer) {
+int block_to_buffer(BCB* block, uint64_t **buffer) {
 
     /*
-        Utility function to convert a block into a buffer. Needed to receive the block from MPI.
+        Utility function to convert a block into a buffer. Needed to send the block over MPI.
+        The buffer contains the white bit rows, the black bit rows and the solution space unknowns packed as bit rows,
+        followed by the search state: the trail size, the number of decisions, the paused flag, the trail cells and the packed decisions.
+        It returns the number of words used in the buffer.
     */
 
-    memcpy(*buffer, block->solution, board.rows_count * board.cols_count * sizeof(CellState));
+    int words_per_row = WORDS_PER_ROW(board.cols_count);
+    int words_count = board.rows_count * words_per_row;
 
-    int i;
-    for (i = 0; i < board.rows_count * board.cols_count; i++)
-        (*buffer)[board.rows_count * board.cols_count + i] = block->solution_space_unknowns[i] ? 1 : 0;
+    memcpy(*buffer, block->white_rows, words_count * sizeof(uint64_t));
+    memcpy(*buffer + words_count, block->black_rows, words_count * sizeof(uint64_t));
+    memset(*buffer + 2 * words_count, 0, words_count * sizeof(uint64_t));
+
+    int i, j;
+    for (i = 0; i < board.rows_count; i++)
+        for (j = 0; j < board.cols_count; j++)
+            if (block->solution_space_unknowns[i * board.cols_count + j])
+                set_bit(*buffer + 2 * words_count, words_per_row, i, j);
+
+    uint64_t *search_state = *buffer + 3 * words_count;
+    search_state[0] = block->trail_size;
+    search_state[1] = block->decisions_count;
+    search_state[2] = block->paused;
+    search_state += 3;
+
+    for (i = 0; i < block->trail_size; i++)
+        *search_state++ = block->trail[i];
+    for (i = 0; i < block->decisions_count; i++)
+        *search_state++ = pack_decision(&block->decisions[i]);
+
+    return search_state - *buffer;
 }
 
-bool buffer_to_block(int *buffer, BCB *block) {
+bool buffer_to_block(uint64_t *buffer, BCB *block) {
 
     /*
-        Utility function to convert a buffer to a block. Needed to send the block over MPI.
+        Utility function to convert a buffer to a block. Needed to receive the block from MPI.
     */
 
-    int i;
+    int words_per_row = WORDS_PER_ROW(board.cols_count);
+    int words_count = board.rows_count * words_per_row;
+
     block->solution = malloc(board.rows_count * board.cols_count * sizeof(CellState));
     block->solution_space_unknowns = malloc(board.rows_count * board.cols_count * sizeof(bool));
     
-    memcpy(block->solution, buffer, board.rows_count * board.cols_count * sizeof(CellState));
-    for (i = 0; i < board.rows_count * board.cols_count; i++) {
-        block->solution_space_unknowns[i] = buffer[board.rows_count * board.cols_count + i] == 1;
+    int i, j;
+    for (i = 0; i < board.rows_count; i++) {
+        for (j = 0; j < board.cols_count; j++) {
+            if (get_bit(buffer, words_per_row, i, j))
+                block->solution[i * board.cols_count + j] = WHITE;
+            else if (get_bit(buffer + words_count, words_per_row, i, j))
+                block->solution[i * board.cols_count + j] = BLACK;
+            else
+                block->solution[i * board.cols_count + j] = UNKNOWN;
+            block->solution_space_unknowns[i * board.cols_count + j] = get_bit(buffer + 2 * words_count, words_per_row, i, j);
+        }
     }
 
+    // The white counters, the bit rows and the black chains are rebuilt from the received solution
+    compute_block_state(board, block);
+    block->nodes = 0;
+
+    // The search state is restored as it was on the sender, so that the search resumes from the same leaf
+    uint64_t *search_state = buffer + 3 * words_count;
+    block->trail_size = search_state[0];
+    block->decisions_count = search_state[1];
+    block->paused = search_state[2];
+    search_state += 3;
+
+    for (i = 0; i < block->trail_size; i++)
+        block->trail[i] = *search_state++;
+    for (i = 0; i < block->decisions_count; i++)
+        unpack_decision(*search_state++, &block->decisions[i]);
+
+    // The black chains are rebuilt following the restored trail, so that backtracking can undo them
+    compute_black_chains(board, block);
+
+    // The nogoods and the reasons of the decisions stay on the sender, the levels of the trail cells are rebuilt from the decisions
+    compute_decision_levels(board, block);
+
     return true;
 }
 
+uint64_t pack_decision(Decision *decision) {
+
+    /*
+        Utility function to pack a decision in a single word: cell, cursor and trail mark take 20 bits each, followed by the first state, the alternative flag and the group line.
+    */
+
+    return (uint64_t) decision->cell
+        | ((uint64_t) decision->cursor << 20)
+        | ((uint64_t) decision->trail_mark << 40)
+        | ((uint64_t) (decision->first_state == BLACK) << 60)
+        | ((uint64_t) decision->alternative_tried << 61)
+        | ((uint64_t) (decision->group_line == COLS) << 62);
+}
+
+void unpack_decision(uint64_t word, Decision *decision) {
+
+    /*
+        Utility function to unpack a decision packed by pack_decision.
+    */
+
+    decision->cell = word & DECISION_FIELD_MASK;
+    decision->cursor = (word >> 20) & DECISION_FIELD_MASK;
+    decision->trail_mark = (word >> 40) & DECISION_FIELD_MASK;
+    decision->first_state = (word >> 60) & 1ULL ? BLACK : WHITE;
+    decision->alternative_tried = (word >> 61) & 1ULL;
+    decision->group_line = (word >> 62) & 1ULL ? COLS : ROWS;
+}
+
 void receive_message(Message *message, int source, MPI_Request *request, int tag) {
     
     if (source == rank && rank != MANAGER_RANK) {
@@ -163,8 +283,9 @@ void init_requests_and_messages() {
     manager_request = MPI_REQUEST_NULL;
     receive_work_request = MPI_REQUEST_NULL;
     refresh_solution_space_request = MPI_REQUEST_NULL;
-    receive_work_buffer = (int *) malloc(board.cols_count * board.rows_count * 2 * sizeof(int));
-    send_work_buffer = (int *) malloc(board.cols_count * board.rows_count * 2 * sizeof(int));
+    block_buffer_size = 3 * board.rows_count * WORDS_PER_ROW(board.cols_count) + 3 + 2 * board.rows_count * board.cols_count;
+    receive_work_buffer = (uint64_t *) malloc(block_buffer_size * sizeof(uint64_t));
+    send_work_buffer = (uint64_t *) malloc(block_buffer_size * sizeof(uint64_t));
     processes_in_my_solution_space = (int *) malloc(size * sizeof(int));
     memset(processes_in_my_solution_space, -1, size * sizeof(int));
     receive_message(&manager_message, MANAGER_RANK, &manager_request, M2W_MESSAGE);
@@ -196,13 +317,15 @@ void worker_receive_work(int source) {
     if (DEBUG && (!flag || status.MPI_SOURCE != -2))
         printf("[ERROR] MPI_Test in worker RECEIVE_WORK failed with flag %d and status %d\n", flag, status.MPI_SOURCE);
 
-    MPI_Irecv(receive_work_buffer, board.cols_count * board.rows_count * 2, MPI_INT, source, W2W_BUFFER, MPI_COMM_WORLD, &receive_work_request);
+    MPI_Irecv(receive_work_buffer, block_buffer_size, MPI_UINT64_T, source, W2W_BUFFER, MPI_COMM_WORLD, &receive_work_request);
     wait_for_message(&receive_work_request);
     if (terminated) return;
 
     BCB block_to_receive;
-    if (buffer_to_block(receive_work_buffer, &block_to_receive))
+    if (buffer_to_block(receive_work_buffer, &block_to_receive)) {
+        if (config.share_nogoods) import_received_nogoods(&block_to_receive);
         enqueue(&solution_queue, &block_to_receive);
+    }
 
     // --- open refresh solution space message channel
     if (total_processes_in_solution_space > 1) {
@@ -229,7 +352,7 @@ void worker_send_work(int destination, int expected_queue_size) {
     if (!invalid_request) {
         if (queue_size == 1) {
             block_to_send = peek(&solution_queue);
-            block_to_buffer(&block_to_send, &send_work_buffer);
+            send_work_buffer_size = block_to_buffer(&block_to_send, &send_work_buffer);
             solutions_to_skip_to_send = total_processes_in_solution_space;
             
             if (DEBUG && processes_in_my_solution_space[destination] == 1)
@@ -256,7 +379,7 @@ void worker_send_work(int destination, int expected_queue_size) {
         }
         else if(queue_size > 1) {
             block_to_send = dequeue(&solution_queue);
-            block_to_buffer(&block_to_send, &send_work_buffer);
+            send_work_buffer_size = block_to_buffer(&block_to_send, &send_work_buffer);
             solutions_to_skip_to_send = 0;
             total_processes_in_solution_space_to_send = 1;
         }
@@ -269,7 +392,7 @@ void worker_send_work(int destination, int expected_queue_size) {
     // --- send buffer
     if (!invalid_request) {
         MPI_Request send_work_buffer_request;
-        MPI_Isend(send_work_buffer, board.cols_count * board.rows_count * 2, MPI_INT, destination, W2W_BUFFER, MPI_COMM_WORLD, &send_work_buffer_request);
+        MPI_Isend(send_work_buffer, send_work_buffer_size, MPI_UINT64_T, destination, W2W_BUFFER, MPI_COMM_WORLD, &send_work_buffer_request);
     }
 }
 
@@ -321,13 +444,12 @@ void worker_check_messages() {
         if (flag) {
             receive_message(&refresh_solution_space_message, status.MPI_SOURCE, &refresh_solution_space_request, W2W_MESSAGE * 4);
             if (refresh_solution_space_message.type == REFRESH_SOLUTION_SPACE) {
-                int buffer_size = board.cols_count * board.rows_count * 2;
-                int refresh_solution_space_buffer[buffer_size];
+                uint64_t refresh_solution_space_buffer[block_buffer_size];
                 
                 if (DEBUG && status.MPI_SOURCE == -2)
                     printf("[ERROR] Process %d got -2 in status.MPI_SOURCE while waiting for buffer solution refresh\n", rank);
                 
-                MPI_Irecv(refresh_solution_space_buffer, buffer_size, MPI_INT, status.MPI_SOURCE, W2W_BUFFER, MPI_COMM_WORLD, &refresh_solution_space_request);
+                MPI_Irecv(refresh_solution_space_buffer, block_buffer_size, MPI_UINT64_T, status.MPI_SOURCE, W2W_BUFFER, MPI_COMM_WORLD, &refresh_solution_space_request);
                 wait_for_message(&refresh_solution_space_request);
                 if (terminated) return;
 
@@ -347,6 +469,7 @@ void manager_consume_message(Message *message, int source) {
         Based on the message type, the manager will take the appropriate action.
 
         TERMINATE: The manager will send a TERMINATE message to all the workers
+        PORTFOLIO_EXHAUSTED: The manager will send a TERMINATE message to all the workers once all the members of a portfolio group have sent it
         STATUS_UPDATE: The manager will update the status of the worker with queue size and processes sharing solution space
         ASK_FOR_WORK: The manager will assign work to the worker with the smallest queue size
     */
@@ -362,6 +485,17 @@ void manager_consume_message(Message *message, int source) {
         }
         terminated = true;
     }
+    else if (message->type == PORTFOLIO_EXHAUSTED) {
+        // When all the members of a group have searched their share, the group has proven that there is no solution
+        int group = message->data1 % portfolio_groups;
+        if (++portfolio_exhausted[group] == portfolio_group_size(size, group) && !terminated) {
+            for (i = 0; i < size; i++) {
+                if (i == MANAGER_RANK) continue;
+                send_message(i, &send_worker_request, TERMINATE, -1, -1, false, M2W_MESSAGE);
+            }
+            terminated = true;
+        }
+    }
     else if (message->type == STATUS_UPDATE) {
         // Update the statues of that worker
         worker_statuses[source].queue_size = message->data1;
@@ -482,6 +616,120 @@ void wait_for_message(MPI_Request *request) {
 
 /* ------------------ MAIN ------------------ */
 
+void init_nogood_exchange() {
+
+    /*
+        Allocate the buffers of the nogood exchange and the pool of the nogoods received from the other processes.
+    */
+
+    int i;
+    nogood_buffer_size = 1 + NOGOOD_SHARE_BATCH * (NOGOOD_SHARE_MAX_LITERALS + 1);
+    nogood_send_buffer = (int *) malloc(nogood_buffer_size * sizeof(int));
+    nogood_receive_buffer = (int *) malloc(nogood_buffer_size * sizeof(int));
+    nogood_send_requests = (MPI_Request *) malloc(size * sizeof(MPI_Request));
+    nogood_sent_counts = (int *) calloc(size, sizeof(int));
+    nogood_received_counts = (int *) calloc(size, sizeof(int));
+    for (i = 0; i < size; i++)
+        nogood_send_requests[i] = MPI_REQUEST_NULL;
+    init_nogood_store(&received_nogoods);
+}
+
+void share_nogoods(BCB *block) {
+
+    /*
+        Send the new nogoods of the block holding on the whole board to all the other processes, then import the ones received.
+        The nogoods depending on the solution space or the cube of the block are kept local. Only the nogoods with at most NOGOOD_SHARE_MAX_LITERALS cells
+        are sent, at most NOGOOD_SHARE_BATCH at a time, and a new batch waits for the previous one to be delivered, which bounds the bandwidth.
+    */
+
+    int i, flag, count = 0, position = 1;
+    NogoodStore *store = &block->nogoods;
+
+    MPI_Testall(size, nogood_send_requests, &flag, MPI_STATUSES_IGNORE);
+    if (flag) {
+        for (i = 0; i < store->count && count < NOGOOD_SHARE_BATCH; i++) {
+            if (store->local[i] || store->exported[i] || store->lengths[i] > NOGOOD_SHARE_MAX_LITERALS) continue;
+            store->exported[i] = true;
+            nogood_send_buffer[position++] = store->lengths[i];
+            memcpy(nogood_send_buffer + position, store->literals + i * NOGOOD_MAX_LITERALS, store->lengths[i] * sizeof(int));
+            position += store->lengths[i];
+            count++;
+        }
+
+        if (count > 0) {
+            nogood_send_buffer[0] = count;
+            for (i = 0; i < size; i++) {
+                if (i == rank) continue;
+                MPI_Isend(nogood_send_buffer, position, MPI_INT, i, NOGOOD_SHARE, MPI_COMM_WORLD, &nogood_send_requests[i]);
+                nogood_sent_counts[i]++;
+            }
+            nogoods_shared += count;
+        }
+    }
+
+    receive_nogoods(block);
+}
+
+void receive_nogoods(BCB *block) {
+
+    /*
+        Receive the pending nogood messages, adding their nogoods to the pool and to the store of the block.
+        A nogood violated by the current assignment of the block is detected by the next decision, which backjumps to the cells involved.
+    */
+
+    int i, position, flag;
+    MPI_Status status;
+
+    while (true) {
+        MPI_Iprobe(MPI_ANY_SOURCE, NOGOOD_SHARE, MPI_COMM_WORLD, &flag, &status);
+        if (!flag) return;
+
+        MPI_Recv(nogood_receive_buffer, nogood_buffer_size, MPI_INT, status.MPI_SOURCE, NOGOOD_SHARE, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        nogood_received_counts[status.MPI_SOURCE]++;
+
+        position = 1;
+        for (i = 0; i < nogood_receive_buffer[0]; i++) {
+            store_nogood(&received_nogoods, nogood_receive_buffer + position + 1, nogood_receive_buffer[position], false, true);
+            store_nogood(&block->nogoods, nogood_receive_buffer + position + 1, nogood_receive_buffer[position], false, true);
+            position += nogood_receive_buffer[position] + 1;
+        }
+    }
+}
+
+void import_received_nogoods(BCB *block) {
+
+    /*
+        Add the nogoods received so far to the store of a new block, marked as exported so that they are not sent back.
+    */
+
+    int i;
+    for (i = 0; i < received_nogoods.count; i++)
+        store_nogood(&block->nogoods, received_nogoods.literals + i * NOGOOD_MAX_LITERALS, received_nogoods.lengths[i], false, true);
+}
+
+void finish_nogood_exchange() {
+
+    /*
+        Called by all the processes after the search: the number of nogood messages sent to each process is exchanged,
+        so that each process receives the ones still in flight before the send requests are completed and the buffers freed.
+    */
+
+    int i, expected_counts[size];
+    MPI_Alltoall(nogood_sent_counts, 1, MPI_INT, expected_counts, 1, MPI_INT, MPI_COMM_WORLD);
+
+    for (i = 0; i < size; i++)
+        for (; nogood_received_counts[i] < expected_counts[i]; nogood_received_counts[i]++)
+            MPI_Recv(nogood_receive_buffer, nogood_buffer_size, MPI_INT, i, NOGOOD_SHARE, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Waitall(size, nogood_send_requests, MPI_STATUSES_IGNORE);
+
+    free(nogood_send_buffer);
+    free(nogood_receive_buffer);
+    free(nogood_send_requests);
+    free(nogood_sent_counts);
+    free(nogood_received_counts);
+    free_nogood_store(&received_nogoods);
+}
+
 bool hitori_mpi_solution() {
 
     int i, count = 0;
@@ -512,8 +760,10 @@ bool hitori_mpi_solution() {
     for (i = 0; i < SOLUTION_SPACES; i++) {
         if (my_solution_spaces[i] == -1) break;
         
-        init_solution_space(board, &blocks[i], my_solution_spaces[i], &unknown_index);
-        leaf_found = build_leaf(board, &blocks[i], 0, 0, &unknown_index, &unknown_index_length, &total_processes_in_solution_space, &solutions_to_skip);
+        // An empty solution space has no leaf
+        leaf_found = init_solution_space(board, &blocks[i], my_solution_spaces[i], &unknown_index) && build_leaf(board, &blocks[i], config, &unknown_index, &unknown_index_length, &total_processes_in_solution_space, &solutions_to_skip);
+        nodes_explored += blocks[i].nodes;
+        blocks[i].nodes = 0;
         
         // check if the leaf is found
         if (leaf_found) {
@@ -568,12 +818,18 @@ bool hitori_mpi_solution() {
             queue_size = getQueueSize(&solution_queue);
             if (queue_size > 0) {
 
-                // Dequeue the block and process it
+                // Dequeue the block and process it, pausing after NOGOOD_SHARE_CONFLICTS conflicts to exchange the nogoods
                 BCB current_solution = dequeue(&solution_queue);
-                leaf_found = next_leaf(board, &current_solution, &unknown_index, &unknown_index_length, &total_processes_in_solution_space, &solutions_to_skip);
-
-                // If the block is a valid leaf, check if it is a solution
-                if (leaf_found) {
+                current_solution.conflict_budget = config.share_nogoods ? NOGOOD_SHARE_CONFLICTS : 0;
+                leaf_found = next_leaf(board, &current_solution, config, &unknown_index, &unknown_index_length, &total_processes_in_solution_space, &solutions_to_skip);
+                nodes_explored += current_solution.nodes;
+                current_solution.nodes = 0;
+
+                // A paused block goes back in the queue, and its search is resumed after checking the messages
+                if (current_solution.paused) {
+                    share_nogoods(&current_solution);
+                    enqueue(&solution_queue, &current_solution);
+                } else if (leaf_found) {
                     if (check_hitori_conditions(board, &current_solution)) {
                         // if it is a solution, set the termination flag and communicate to the manager
                         terminated = true;
@@ -606,6 +862,450 @@ bool hitori_mpi_solution() {
     return false;
 }
 
+void send_cube_termination(int worker) {
+
+    /*
+        The manager sends the termination to a worker, with the rank of the process whose solution is kept.
+        Each worker receives it exactly once, either as the answer to a request or while it is searching a cube.
+    */
+
+    int termination[2] = {-1, cube_winner};
+    MPI_Send(termination, 2, MPI_INT, worker, CUBE_ASSIGN, MPI_COMM_WORLD);
+    cube_terminated_workers[worker] = true;
+}
+
+void terminate_cube_workers() {
+
+    /*
+        The manager sends the termination to all the workers that did not receive it yet.
+    */
+
+    int i;
+    for (i = 0; i < size; i++)
+        if (i != MANAGER_RANK && !cube_terminated_workers[i])
+            send_cube_termination(i);
+}
+
+void manager_serve_cube_requests(bool wait) {
+
+    /*
+        The manager consumes the requests of the workers:
+            CUBE_ASK: the next cube is sent, or the termination if there are no cubes left or a solution has been found
+            CUBE_FOUND: the first solution found is kept, and all the workers are terminated
+            CUBE_DONE: the worker will not send any other request
+        Without wait it returns as soon as there are no pending requests, with wait it returns when all the workers are done.
+    */
+
+    int flag, request, source;
+    MPI_Status status;
+
+    while (done_workers < size - 1) {
+        if (wait) {
+            MPI_Probe(MPI_ANY_SOURCE, CUBE_REQUEST, MPI_COMM_WORLD, &status);
+            flag = 1;
+        } else
+            MPI_Iprobe(MPI_ANY_SOURCE, CUBE_REQUEST, MPI_COMM_WORLD, &flag, &status);
+        if (!flag) return;
+
+        source = status.MPI_SOURCE;
+        MPI_Recv(&request, 1, MPI_INT, source, CUBE_REQUEST, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+        if (request == CUBE_DONE)
+            done_workers++;
+        else if (request == CUBE_FOUND && !terminated) {
+            terminated = true;
+            cube_winner = source;
+            terminate_cube_workers();
+        } else if (request == CUBE_ASK && !cube_terminated_workers[source]) {
+            if (!terminated && next_cube < cubes_count) {
+                cube_buffer[0] = cubes[next_cube].literals_count;
+                memcpy(cube_buffer + 1, cubes[next_cube].literals, cubes[next_cube].literals_count * sizeof(int));
+                MPI_Send(cube_buffer, cube_buffer[0] + 1, MPI_INT, source, CUBE_ASSIGN, MPI_COMM_WORLD);
+                next_cube++;
+            } else
+                send_cube_termination(source);
+        }
+    }
+}
+
+void poll_cube_termination() {
+
+    /*
+        Check for the termination while searching a cube: the manager serves the pending requests,
+        a worker checks if the manager sent it the termination, the only message it can receive while searching.
+    */
+
+    if (rank == MANAGER_RANK) {
+        manager_serve_cube_requests(false);
+        return;
+    }
+
+    int flag = 0;
+    MPI_Iprobe(MANAGER_RANK, CUBE_ASSIGN, MPI_COMM_WORLD, &flag, MPI_STATUS_IGNORE);
+    if (flag) {
+        MPI_Recv(cube_buffer, board.rows_count * board.cols_count + 1, MPI_INT, MANAGER_RANK, CUBE_ASSIGN, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        cube_winner = cube_buffer[1];
+        terminated = true;
+    }
+}
+
+bool search_cube(int *literals, int literals_count) {
+
+    /*
+        The cube is applied to a block of the pruned board, then its leaves are searched one at a time, checking the termination after each one.
+        The search also pauses every CUBE_POLL_CONFLICTS conflicts to check the termination, so a long cube does not hold up the requests.
+        With the nogood exchange, the block starts with the nogoods received so far, and the search pauses every NOGOOD_SHARE_CONFLICTS conflicts
+        instead, to exchange them too.
+        It returns true if a solution is found, copied to the board solution.
+    */
+
+    int processes_in_cube = 1, leaves_to_skip = 0;
+    bool solution_found = false;
+
+    BCB block;
+    init_probe_block(board, &block);
+    if (config.share_nogoods) import_received_nogoods(&block);
+    block.conflict_budget = config.share_nogoods ? NOGOOD_SHARE_CONFLICTS : CUBE_POLL_CONFLICTS;
+    bool leaf_found = apply_cube(board, &block, literals, literals_count)
+        && build_leaf(board, &block, config, &unknown_index, &unknown_index_length, &processes_in_cube, &leaves_to_skip);
+
+    while (leaf_found || block.paused) {
+        if (leaf_found && check_hitori_conditions(board, &block)) {
+            solution_found = true;
+            memcpy(board.solution, block.solution, board.rows_count * board.cols_count * sizeof(CellState));
+            break;
+        }
+
+        if (block.paused && config.share_nogoods) share_nogoods(&block);
+        poll_cube_termination();
+        if (terminated) break;
+        block.conflict_budget = config.share_nogoods ? NOGOOD_SHARE_CONFLICTS : CUBE_POLL_CONFLICTS;
+        leaf_found = next_leaf(board, &block, config, &unknown_index, &unknown_index_length, &processes_in_cube, &leaves_to_skip);
+    }
+
+    nodes_explored += block.nodes;
+    free_block(&block);
+    return solution_found;
+}
+
+bool hitori_mpi_cubes() {
+
+    /*
+        The manager splits the board into CUBES_PER_PROCESS cubes per process, then hands them out on request, the hardest first.
+        A process that finishes a cube asks for the next one, so the processes stay busy until the cubes run out.
+        The manager searches the cubes too, serving the requests between its leaves. The first process finding a solution
+        tells the manager, which terminates all the workers and waits for each of them to confirm.
+    */
+
+    int request;
+    cube_buffer = (int *) malloc((board.rows_count * board.cols_count + 2) * sizeof(int));
+
+    if (rank == MANAGER_RANK) {
+        cubes_count = generate_cubes(board, CUBES_PER_PROCESS * size, &cubes);
+        cube_terminated_workers = (bool *) calloc(size, sizeof(bool));
+        if (DEBUG) printf("[%d] Generated %d cubes\n", rank, cubes_count);
+
+        while (!terminated) {
+            manager_serve_cube_requests(false);
+            if (terminated || next_cube >= cubes_count) break;
+
+            Cube *cube = &cubes[next_cube++];
+            if (search_cube(cube->literals, cube->literals_count)) {
+                terminated = true;
+                cube_winner = MANAGER_RANK;
+                terminate_cube_workers();
+            }
+        }
+
+        // Wait for the workers still searching their cubes
+        manager_serve_cube_requests(true);
+
+        int i;
+        for (i = 0; i < cubes_count; i++)
+            free(cubes[i].literals);
+        free(cubes);
+        free(cube_terminated_workers);
+    } else {
+        while (!terminated) {
+            request = CUBE_ASK;
+            MPI_Send(&request, 1, MPI_INT, MANAGER_RANK, CUBE_REQUEST, MPI_COMM_WORLD);
+            MPI_Recv(cube_buffer, board.rows_count * board.cols_count + 1, MPI_INT, MANAGER_RANK, CUBE_ASSIGN, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+            if (cube_buffer[0] == -1) {
+                cube_winner = cube_buffer[1];
+                terminated = true;
+            } else if (search_cube(cube_buffer + 1, cube_buffer[0])) {
+                // Tell the manager, then wait for the termination that says which solution is kept
+                request = CUBE_FOUND;
+                MPI_Send(&request, 1, MPI_INT, MANAGER_RANK, CUBE_REQUEST, MPI_COMM_WORLD);
+                MPI_Recv(cube_buffer, board.rows_count * board.cols_count + 1, MPI_INT, MANAGER_RANK, CUBE_ASSIGN, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                cube_winner = cube_buffer[1];
+                terminated = true;
+            }
+        }
+
+        request = CUBE_DONE;
+        MPI_Send(&request, 1, MPI_INT, MANAGER_RANK, CUBE_REQUEST, MPI_COMM_WORLD);
+    }
+
+    free(cube_buffer);
+    return cube_winner == rank;
+}
+
+bool hitori_mpi_portfolio() {
+
+    /*
+        The processes are split into groups, each one searching the whole board with its own configuration (see portfolio_config).
+        The members of a group split its solution spaces and search them alone with the conflict analysis, checking the messages
+        every PORTFOLIO_POLL_CONFLICTS conflicts. The first process finding a solution sends TERMINATE to the manager, which forwards it
+        to all the others. A process that exhausts its share tells the manager, which terminates all the processes once a whole group has.
+    */
+
+    portfolio_groups = portfolio_groups_count(size);
+    int group = rank % portfolio_groups, group_size = portfolio_group_size(size, group);
+    SolverConfig member_config = portfolio_config(config, group);
+    if (rank == MANAGER_RANK) portfolio_exhausted = (int *) calloc(portfolio_groups, sizeof(int));
+
+    int i, processes_in_space = 1, leaves_to_skip = 0;
+    bool leaf_found, solution_found = false;
+    BCB block;
+
+    for (i = rank / portfolio_groups; i < SOLUTION_SPACES && !terminated && !solution_found; i += group_size) {
+        if (!init_solution_space(board, &block, i, &unknown_index)) {
+            free_block(&block);
+            continue;
+        }
+        if (config.share_nogoods) import_received_nogoods(&block);
+        block.conflict_budget = PORTFOLIO_POLL_CONFLICTS;
+        leaf_found = build_leaf(board, &block, member_config, &unknown_index, &unknown_index_length, &processes_in_space, &leaves_to_skip);
+
+        while (leaf_found || block.paused) {
+            if (leaf_found && check_hitori_conditions(board, &block)) {
+                solution_found = true;
+                memcpy(board.solution, block.solution, board.rows_count * board.cols_count * sizeof(CellState));
+                break;
+            }
+
+            if (block.paused && config.share_nogoods) share_nogoods(&block);
+            if (rank == MANAGER_RANK) manager_check_messages();
+            worker_check_messages();
+            if (terminated) break;
+            block.conflict_budget = PORTFOLIO_POLL_CONFLICTS;
+            leaf_found = next_leaf(board, &block, member_config, &unknown_index, &unknown_index_length, &processes_in_space, &leaves_to_skip);
+        }
+
+        nodes_explored += block.nodes;
+        free_block(&block);
+    }
+
+    /*
+        The manager does not forward the termination to the process that sent it, which stops right away. The manager itself
+        stops when it consumes its own message.
+    */
+
+    if (solution_found) {
+        if (rank != MANAGER_RANK) terminated = true;
+        MPI_Request terminate_message_request = MPI_REQUEST_NULL;
+        send_message(MANAGER_RANK, &terminate_message_request, TERMINATE, rank, -1, false, W2M_MESSAGE);
+    } else if (!terminated) {
+        MPI_Request exhausted_request = MPI_REQUEST_NULL;
+        send_message(MANAGER_RANK, &exhausted_request, PORTFOLIO_EXHAUSTED, rank, -1, false, W2M_MESSAGE);
+    }
+
+    while (!terminated) {
+        if (rank == MANAGER_RANK) manager_check_messages();
+        worker_check_messages();
+    }
+
+    // More than one process may have found a solution before the termination, the one of the lowest rank is kept
+    int local_winner = solution_found ? size - rank : 0, global_winner;
+    MPI_Allreduce(&local_winner, &global_winner, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    if (rank == MANAGER_RANK) free(portfolio_exhausted);
+
+    if (global_winner > 0 && global_winner == size - rank)
+        printf("[%d] Solution found by the portfolio group %d\n", rank, group);
+    return global_winner > 0 && global_winner == size - rank;
+}
+
+bool hitori_mpi_row_patterns() {
+
+    /*
+        Each process searches the masks of the first row congruent to its rank. After every ROW_SEARCH_STEPS masks
+        the processes agree on the termination: the search stops as soon as one of them has found a solution, keeping
+        the one of the lowest rank, or when all of them have exhausted their masks.
+    */
+
+    RowSearch search;
+    init_row_search(board, &row_patterns, &search, rank, size);
+
+    RowSearchResult result = ROW_SEARCH_PAUSED;
+    int local_state[2], global_state[2];
+    while (true) {
+        if (result == ROW_SEARCH_PAUSED)
+            result = search_row_patterns(board, &row_patterns, &search, ROW_SEARCH_STEPS);
+
+        // The first value identifies the lowest rank with a solution, the second one is set while a process is still searching
+        local_state[0] = result == ROW_SEARCH_FOUND ? size - rank : 0;
+        local_state[1] = result == ROW_SEARCH_PAUSED;
+        MPI_Allreduce(local_state, global_state, 2, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        if (global_state[0] > 0 || global_state[1] == 0) break;
+    }
+
+    bool solution_found = global_state[0] == size - rank;
+    if (solution_found) row_search_to_solution(board, &search, board.solution);
+
+    nodes_explored += search.nodes;
+    free_row_search(&search);
+    return solution_found;
+}
+
+bool hitori_mpi_cdcl() {
+
+    /*
+        Each process runs its own solver on the whole board, seeded with its rank so that the processes decide the cells in different orders.
+        After every CDCL_SEARCH_CONFLICTS conflicts the processes agree on the termination: the search stops as soon as one of them
+        has found a solution, keeping the one of the lowest rank, or has proven that there is none.
+    */
+
+    CdclSolver solver;
+    init_cdcl_solver(board, &solver, rank + 1);
+
+    CdclResult result = CDCL_PAUSED;
+    int local_state[2], global_state[2];
+    while (true) {
+        if (result == CDCL_PAUSED)
+            result = search_cdcl(board, &solver, CDCL_SEARCH_CONFLICTS);
+
+        // The first value identifies the lowest rank with a solution, the second one is set when a process has proven there is none
+        local_state[0] = result == CDCL_SATISFIABLE ? size - rank : 0;
+        local_state[1] = result == CDCL_UNSATISFIABLE;
+        MPI_Allreduce(local_state, global_state, 2, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        if (global_state[0] > 0 || global_state[1] > 0) break;
+    }
+
+    bool solution_found = global_state[0] == size - rank;
+    if (solution_found) cdcl_to_solution(board, &solver, board.solution);
+
+    nodes_explored += solver.nodes;
+    free_cdcl_solver(&solver);
+    return solution_found;
+}
+
+bool hitori_mpi_frontier(bool *solution_found) {
+
+    /*
+        Sweep the board cell by cell with the frontier engine, the states of each layer split among the processes by their hash,
+        so that equal states always meet on the same process. Each process expands its states and sends each candidate to the process
+        owning it, with its number of partial solutions and its origin, then merges the candidates it receives.
+        All the solutions are counted, and the first state of the last layer on the lowest rank is rebuilt backwards,
+        each step broadcast by the process owning the state. It returns false, on all the processes, if a process exceeds
+        its maximum number of states, in which case the board has to be searched by another engine.
+    */
+
+    FrontierSweep sweep;
+    init_frontier_sweep(board, &sweep);
+    if (FRONTIER_OWNER(hash_frontier_state(sweep.states, sweep.state_words), size) != rank) sweep.states_count = 0;
+
+    int i, candidate, owner, cell_index, position;
+    int record_words = sweep.state_words + 2;
+    int *send_counts = (int *) malloc(size * sizeof(int));
+    int *send_displacements = (int *) malloc(size * sizeof(int));
+    int *receive_counts = (int *) malloc(size * sizeof(int));
+    int *receive_displacements = (int *) malloc(size * sizeof(int));
+    int *owners = NULL;
+    uint64_t *send_buffer = NULL, *receive_buffer = NULL;
+    int local_state[2], global_state[2] = {0, 1};
+
+    for (cell_index = 0; cell_index < sweep.cells_count && global_state[1] > 0; cell_index++) {
+        prepare_frontier_layer(&sweep);
+        expand_frontier_states(board, &sweep, cell_index, 0, sweep.states_count);
+
+        // Each candidate is sent as its state, its number of partial solutions and its origin
+        owners = (int *) realloc(owners, (2 * sweep.states_count + 1) * sizeof(int));
+        memset(send_counts, 0, size * sizeof(int));
+        for (candidate = 0; candidate < 2 * sweep.states_count; candidate++) {
+            if (!sweep.valid[candidate]) continue;
+            owners[candidate] = FRONTIER_OWNER(hash_frontier_state(sweep.candidates + candidate * sweep.state_words, sweep.state_words), size);
+            send_counts[owners[candidate]] += record_words;
+        }
+        MPI_Alltoall(send_counts, 1, MPI_INT, receive_counts, 1, MPI_INT, MPI_COMM_WORLD);
+
+        send_displacements[0] = receive_displacements[0] = 0;
+        for (i = 1; i < size; i++) {
+            send_displacements[i] = send_displacements[i - 1] + send_counts[i - 1];
+            receive_displacements[i] = receive_displacements[i - 1] + receive_counts[i - 1];
+        }
+        send_buffer = (uint64_t *) realloc(send_buffer, (send_displacements[size - 1] + send_counts[size - 1] + 1) * sizeof(uint64_t));
+        receive_buffer = (uint64_t *) realloc(receive_buffer, (receive_displacements[size - 1] + receive_counts[size - 1] + 1) * sizeof(uint64_t));
+
+        memset(send_counts, 0, size * sizeof(int));
+        for (candidate = 0; candidate < 2 * sweep.states_count; candidate++) {
+            if (!sweep.valid[candidate]) continue;
+            owner = owners[candidate];
+            position = send_displacements[owner] + send_counts[owner];
+            memcpy(send_buffer + position, sweep.candidates + candidate * sweep.state_words, sweep.state_words * sizeof(uint64_t));
+            send_buffer[position + sweep.state_words] = (uint64_t) sweep.counts[candidate / 2];
+            send_buffer[position + sweep.state_words + 1] = (uint64_t) FRONTIER_ORIGIN(rank, candidate);
+            send_counts[owner] += record_words;
+        }
+        MPI_Alltoallv(send_buffer, send_counts, send_displacements, MPI_UINT64_T,
+                      receive_buffer, receive_counts, receive_displacements, MPI_UINT64_T, MPI_COMM_WORLD);
+
+        for (position = 0; position < receive_displacements[size - 1] + receive_counts[size - 1] && !sweep.overflow; position += record_words)
+            merge_frontier_state(&sweep, receive_buffer + position, (long long) receive_buffer[position + sweep.state_words],
+                                 (long long) receive_buffer[position + sweep.state_words + 1]);
+        finish_frontier_layer(&sweep);
+
+        // The first value is set when a process overflows, the second one while a process has states left
+        local_state[0] = sweep.overflow;
+        local_state[1] = sweep.states_count > 0 && !sweep.overflow;
+        MPI_Allreduce(local_state, global_state, 2, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        if (global_state[0] > 0) break;
+    }
+
+    free(owners);
+    free(send_buffer);
+    free(receive_buffer);
+    free(send_counts);
+    free(send_displacements);
+    free(receive_counts);
+    free(receive_displacements);
+
+    nodes_explored += sweep.stored_states;
+    bool available = global_state[0] == 0;
+    *solution_found = false;
+    if (!available) {
+        free_frontier_sweep(&sweep);
+        return false;
+    }
+
+    long long solutions_count = 0;
+    MPI_Reduce(&sweep.solutions_count, &solutions_count, 1, MPI_LONG_LONG, MPI_SUM, MANAGER_RANK, MPI_COMM_WORLD);
+    if (rank == MANAGER_RANK) printf("[%d] Solutions counted: %lld\n", rank, solutions_count);
+
+    // The first value identifies the lowest rank with a state in the last layer
+    local_state[0] = sweep.layers_count == sweep.cells_count && sweep.states_count > 0 ? size - rank : 0;
+    MPI_Allreduce(local_state, global_state, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+    if (global_state[0] > 0) {
+        long long origin;
+        int layer, state_index = 0;
+        owner = size - global_state[0];
+        *solution_found = owner == rank;
+        for (layer = sweep.cells_count - 1; layer >= 0; layer--) {
+            if (owner == rank) origin = sweep.origins[layer][state_index];
+            MPI_Bcast(&origin, 1, MPI_LONG_LONG, owner, MPI_COMM_WORLD);
+            candidate = FRONTIER_ORIGIN_CANDIDATE(origin);
+            board.solution[layer] = FRONTIER_CANDIDATE_STATE(candidate);
+            owner = FRONTIER_ORIGIN_RANK(origin);
+            state_index = candidate / 2;
+        }
+    }
+
+    free_frontier_sweep(&sweep);
+    return true;
+}
+
 int main(int argc, char** argv) {
 
     /*
@@ -622,6 +1322,10 @@ int main(int argc, char** argv) {
     */
 
     if (rank == MANAGER_RANK) read_board(&board, argv[1]);
+    config = read_config(argc, argv);
+
+    // With the restarts, each process draws its random orders from its own seed
+    config.seed += rank;
     
     /*
         Share the board with all the processes
@@ -651,39 +1355,34 @@ int main(int argc, char** argv) {
             mpi_sandwich_rules,
             mpi_pair_isolation,
             mpi_flanked_isolation,
-            mpi_corner_cases
+            mpi_corner_cases,
+            mpi_two_sat_rule,
+            mpi_articulation_point_rule
         };
         int num_techniques = sizeof(techniques) / sizeof(techniques[0]);
 
-        board = techniques[0](board, rank, min_workers, PRUNING_COMM);
-        
-        int i;
-        for (i = 1; i < num_techniques; i++)
-            board = combine_boards(board, techniques[i](board, rank, min_workers, PRUNING_COMM), false, rank, "Partial", PRUNING_COMM);
-        
         /*
-            Repeat the whiting and blacking pruning techniques until the solution doesn't change
+            Merge each partial solution in place into the board solution, starting from the unknown solution read with the board.
+            The merge aborts if a technique marks white a cell marked black by another one, or vice versa
         */
 
-        while (true) {
-
-            Board white_solution = mpi_set_white(board, rank, min_workers, PRUNING_COMM);
-            Board black_solution = mpi_set_black(board, rank, min_workers, PRUNING_COMM);
-
-            Board partial = combine_boards(board, white_solution, false, rank, "Partial", PRUNING_COMM);
-            Board new_solution = combine_boards(partial, black_solution, false, rank, "Partial", PRUNING_COMM);
-
-            if(!is_board_solution_equal(board, new_solution)) 
-                board = new_solution;
-            else 
-                break;
+        int i, cells_count = board.rows_count * board.cols_count;
+        for (i = 0; i < num_techniques; i++) {
+            Board partial = techniques[i](board, rank, min_workers, PRUNING_COMM);
+            mpi_merge_solutions(board.solution, partial.solution, cells_count, false, rank, "pruning techniques", PRUNING_COMM);
+            free(partial.solution);
         }
+        
+        /*
+            Propagate the known cells with the whiting and blacking rules until the solution doesn't change
+        */
+
+        Board propagated = mpi_fixed_point_propagation(board, rank, min_workers, PRUNING_COMM);
+        free(board.solution);
+        board = propagated;
     }
-    double pruning_end_time = MPI_Wtime();
 
     if (PRUNING_COMM != MPI_COMM_NULL) MPI_Comm_free(&PRUNING_COMM);
-    
-    if (DEBUG && rank == MANAGER_RANK) print_board("Pruned", board, SOLUTION);
 
     /*
         Share the pruned board with all the processes
@@ -691,6 +1390,17 @@ int main(int argc, char** argv) {
 
     mpi_share_board(&board, rank);
 
+    /*
+        Probe the remaining unknown cells on all the processes, fixing the ones whose other state leads to a conflict, until nothing changes
+    */
+
+    Board probed = mpi_failed_literal_probing(board, rank, size, MPI_COMM_WORLD);
+    free(board.solution);
+    board = probed;
+    double pruning_end_time = MPI_Wtime();
+    
+    if (DEBUG && rank == MANAGER_RANK) print_board("Pruned", board, SOLUTION);
+
     /*
         Initialize the backtracking variables
     */
@@ -705,14 +1415,41 @@ int main(int argc, char** argv) {
     compute_unknowns(board, &unknown_index, &unknown_index_length);
     
     /*
-        Apply the recursive backtracking algorithm to find the solution
+        Apply the selected engine to find the solution. The row patterns engine falls back to the backtracking
+        when the board has too many columns or rows with too many legal masks, the frontier engine when it has too many columns or states,
+        the same for all the processes.
     */
 
     double recursive_start_time = MPI_Wtime();
-    bool solution_found = hitori_mpi_solution();
+    bool solution_found;
+    if (config.engine == CDCL) {
+        solution_found = hitori_mpi_cdcl();
+    } else if (config.engine == ROW_PATTERNS && build_row_patterns(board, &row_patterns)) {
+        solution_found = hitori_mpi_row_patterns();
+        free_row_patterns(&row_patterns);
+    } else if (config.engine == FRONTIER && board.cols_count <= FRONTIER_MAX_COLS && hitori_mpi_frontier(&solution_found)) {
+        // The sweep found the solution, or proved that there is none
+    } else {
+        if (config.engine == ROW_PATTERNS && rank == MANAGER_RANK)
+            printf("[%d] Row patterns not available for this board, using the backtracking\n", rank);
+        if (config.engine == FRONTIER && rank == MANAGER_RANK)
+            printf("[%d] Frontier engine not available for this board, using the backtracking\n", rank);
+        if (config.share_nogoods) init_nogood_exchange();
+        if (config.portfolio)
+            solution_found = hitori_mpi_portfolio();
+        else
+            solution_found = config.work_split == CUBES_SPLIT ? hitori_mpi_cubes() : hitori_mpi_solution();
+        if (config.share_nogoods) finish_nogood_exchange();
+    }
     double recursive_end_time = MPI_Wtime();
 
     MPI_Barrier(MPI_COMM_WORLD);
+
+    long long total_nodes_explored = 0;
+    MPI_Reduce(&nodes_explored, &total_nodes_explored, 1, MPI_LONG_LONG, MPI_SUM, MANAGER_RANK, MPI_COMM_WORLD);
+
+    long long total_nogoods_shared = 0;
+    MPI_Reduce(&nogoods_shared, &total_nogoods_shared, 1, MPI_LONG_LONG, MPI_SUM, MANAGER_RANK, MPI_COMM_WORLD);
     
     /*
         Print all the times
@@ -724,6 +1461,10 @@ int main(int argc, char** argv) {
     
     if (rank == MANAGER_RANK) printf("[%d] Total execution time: %f\n", rank, recursive_end_time - pruning_start_time);
 
+    if (rank == MANAGER_RANK) printf("[%d] Nodes explored: %lld (%.0f nodes/sec)\n", rank, total_nodes_explored, total_nodes_explored / (recursive_end_time - recursive_start_time));
+
+    if (rank == MANAGER_RANK && total_nogoods_shared > 0) printf("[%d] Nogoods shared: %lld\n", rank, total_nogoods_shared);
+
     MPI_Barrier(MPI_COMM_WORLD);
 
     /*
@@ -746,10 +1487,10 @@ int main(int argc, char** argv) {
     free_memory((int *[]){
         unknown_index, 
         unknown_index_length, 
-        processes_in_my_solution_space, 
-        receive_work_buffer, 
-        send_work_buffer
+        processes_in_my_solution_space
     });
+    free(receive_work_buffer);
+    free(send_work_buffer);
     
     free(worker_messages);
     free(worker_requests);
@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/patterns.h"
+
+int compile_patterns(PatternRule *table, int table_count, PatternRule *rules) {
+
+    /*
+        This function is responsible for compiling a table of pattern rules into the masks used by the matcher: the pairs of cells of each
+        rule with the same letter must have equal values, the pairs with different letters different values, and the cells with a letter
+        must be on the board. A window is then matched against a rule with three mask tests, see apply_patterns.
+        It returns the number of rules compiled.
+    */
+
+    /*
+        Parameters:
+            table: the rules as written, with their name, classes and states
+            table_count: the number of rules of the table, at most PATTERN_MAX_RULES
+            rules: the vector filled with the compiled rules
+    */
+
+    int rule, i, j;
+
+    if (table_count > PATTERN_MAX_RULES) {
+        printf("[ERROR] Too many pattern rules, at most %d are supported\n", PATTERN_MAX_RULES);
+        exit(-1);
+    }
+
+    for (rule = 0; rule < table_count; rule++) {
+        PatternRule *pattern = &rules[rule];
+        *pattern = table[rule];
+        pattern->cells_count = strlen(pattern->classes);
+        pattern->equal_pairs = 0;
+        pattern->different_pairs = 0;
+        pattern->required_cells = 0;
+
+        if (pattern->cells_count > PATTERN_MAX_CELLS || strlen(pattern->states) != pattern->cells_count) {
+            printf("[ERROR] The pattern rule %s must have the same number of classes and states, at most %d\n", pattern->name, PATTERN_MAX_CELLS);
+            exit(-1);
+        }
+
+        for (i = 0; i < pattern->cells_count; i++) {
+            if (pattern->classes[i] == '*') continue;
+            pattern->required_cells |= 1u << i;
+
+            for (j = i + 1; j < pattern->cells_count; j++) {
+                if (pattern->classes[j] == '*') continue;
+                if (pattern->classes[i] == pattern->classes[j]) pattern->equal_pairs |= PATTERN_PAIR(i, j);
+                else pattern->different_pairs |= PATTERN_PAIR(i, j);
+            }
+        }
+    }
+    return table_count;
+}
+
+int line_patterns(PatternRule *rules) {
+
+    /*
+        This function is responsible for compiling the pattern rules of the rows and columns. The window of a rule starts one cell before
+        the cell being swept, so a rule may begin with one '*' for the cell before it. The rules are matched in the direction of the sweep
+        only, a rule that is not symmetric must be written in both directions.
+        It returns the number of rules.
+    */
+
+    /*
+        Parameters:
+            rules: the vector filled with the compiled rules, PATTERN_MAX_RULES long
+    */
+
+    PatternRule table[] = {
+        { "Sandwich Triple", "*aaa*", "OXOXO" },    // 2 2 2 --> X O X, and the cells around them are white
+        { "Sandwich Pair",   "aba",   ".O."   }     // 2 3 2 --> 2 O 2
+    };
+
+    return compile_patterns(table, sizeof(table) / sizeof(table[0]), rules);
+}
+
+int corner_patterns(PatternRule *rules) {
+
+    /*
+        This function is responsible for compiling the pattern rules of the corners of the board. The window is the 2x2 block of a corner,
+        as seen from the top left corner: the corner cell, its neighbour on the row, its neighbour on the column and the diagonal cell.
+        compute_corner orients the window on each corner, so the rules are written once for the four corners.
+        It returns the number of rules.
+    */
+
+    /*
+        Parameters:
+            rules: the vector filled with the compiled rules, PATTERN_MAX_RULES long
+    */
+
+    PatternRule table[] = {
+        { "Triple Corner",       "aaa*", "XOO." },  // Three equal values around the corner cell, the corner cell is black
+        { "Triple Inner Corner", "*aaa", ".OOX" },  // Three equal values around the diagonal cell, the diagonal cell is black
+        { "Pair Corner",         "aa**", "..O." },  // A pair on the corner cell, its other neighbour is white
+        { "Pair Corner",         "a*a*", ".O.." },
+        { "Pair Inner Corner",   "**aa", ".O.." },  // A pair on the diagonal cell, the neighbour of the corner cell out of the pair is white
+        { "Pair Inner Corner",   "*a*a", "..O." },
+        { "Quad Corner",         "aabb", "XOOX" },  // Two parallel pairs, the corner and the diagonal cells are black
+        { "Quad Corner",         "abab", "XOOX" },
+        { "Quad Corner",         "aaaa", "XOOX" }
+    };
+
+    return compile_patterns(table, sizeof(table) / sizeof(table[0]), rules);
+}
+
+int apply_patterns(PatternRule *rules, int rules_count, int *values, int *cells, int *solution) {
+
+    /*
+        This function is responsible for matching a window against all the compiled rules at once: the pairs of equal values of the window
+        are computed once, then a rule matches when its cells are on the board, its equal pairs are equal and its different pairs are not.
+        The states of the matching rules are written into the solution. It returns the number of conflicting deductions.
+    */
+
+    /*
+        Parameters:
+            rules: the compiled rules
+            rules_count: the number of rules
+            values: the values of the cells of the window, PATTERN_MAX_CELLS long, 0 for the cells past the border
+            cells: the indexes of the cells of the window in the board
+            solution: the solution the deductions are written into
+    */
+
+    uint32_t equal_pairs = 0, present_cells = 0;
+    int rule, i, j, conflicts = 0;
+
+    for (i = 0; i < PATTERN_MAX_CELLS; i++) {
+        if (values[i] == 0) continue;
+        present_cells |= 1u << i;
+
+        for (j = i + 1; j < PATTERN_MAX_CELLS; j++)
+            if (values[j] == values[i]) equal_pairs |= PATTERN_PAIR(i, j);
+    }
+
+    for (rule = 0; rule < rules_count; rule++) {
+        PatternRule *pattern = &rules[rule];
+        if ((pattern->required_cells & ~present_cells) || (pattern->equal_pairs & ~equal_pairs) || (pattern->different_pairs & equal_pairs)) continue;
+
+        for (i = 0; i < pattern->cells_count; i++) {
+            if (!(present_cells & (1u << i)) || pattern->states[i] == '.') continue;
+            conflicts += mark_cell(solution, cells[i], pattern->states[i] == 'X' ? BLACK : WHITE);
+        }
+    }
+    return conflicts;
+}
+
+int mark_cell(int *solution, int cell_index, CellState cell_state) {
+
+    /*
+        This function is responsible for writing a deduction into a solution shared by several rules: an unknown cell takes the state,
+        a cell already holding the other state is a conflict. It returns 1 on a conflict, 0 otherwise.
+    */
+
+    /*
+        Parameters:
+            solution: the solution the rules write into
+            cell_index: the index of the cell in the board
+            cell_state: the state deduced for the cell
+    */
+
+    if (solution[cell_index] == UNKNOWN) solution[cell_index] = cell_state;
+    return solution[cell_index] != cell_state;
+}
@@ -1,10 +1,18 @@
 #include <mpi.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "../include/pruning.h"
 #include "../include/board.h"
+#include "../include/occurrences.h"
+#include "../include/patterns.h"
 #include "../include/utils.h"
+#include "../include/black_chains.h"
+#include "../include/two_sat.h"
+#include "../include/articulation.h"
+#include "../include/probing.h"
+#include "../include/backtracking.h"
 
 Board mpi_uniqueness_rule(Board board, int rank, int size, MPI_Comm PRUNING_COMM) {
 
@@ -22,7 +30,7 @@ Board mpi_uniqueness_rule(Board board, int rank, int size, MPI_Comm PRUNING_COMM
     int *local_col, *counts_send_col, *displs_send_col;
     mpi_scatter_board(board, rank, size, COLS, BOARD, &local_col, &counts_send_col, &displs_send_col, PRUNING_COMM);
     
-    int i, j, k;
+    int i, j;
     int local_row_solution[counts_send_row[rank]];
     int local_col_solution[counts_send_col[rank]];
 
@@ -33,20 +41,15 @@ Board mpi_uniqueness_rule(Board board, int rank, int size, MPI_Comm PRUNING_COMM
     memset(local_row_solution, UNKNOWN, counts_send_row[rank] * sizeof(int));
     memset(local_col_solution, UNKNOWN, counts_send_col[rank] * sizeof(int));
 
+    int first_row = displs_send_row[rank] / board.cols_count, first_col = displs_send_col[rank] / board.rows_count;
+    const int *positions;
+
     // For each local row, check if there are unique values
     for (i = 0; i < (counts_send_row[rank] / board.cols_count); i++) {
         for (j = 0; j < board.cols_count; j++) {
-            bool unique = true;
             int value = local_row[i * board.cols_count + j];
 
-            for (k = 0; k < board.cols_count; k++) {
-                if (j != k && value == local_row[i * board.cols_count + k]) {
-                    unique = false;
-                    break;
-                }
-            }
-
-            if (unique)
+            if (row_occurrences(board, first_row + i, value, &positions) == 1)
                 local_row_solution[i * board.cols_count + j] = WHITE; // If the value is unique, mark it as white
             else
                 local_row_solution[i * board.cols_count + j] = UNKNOWN;
@@ -56,17 +59,9 @@ Board mpi_uniqueness_rule(Board board, int rank, int size, MPI_Comm PRUNING_COMM
     // For each local column, check if there are unique values
     for (i = 0; i < (counts_send_col[rank] / board.rows_count); i++) {
         for (j = 0; j < board.rows_count; j++) {
-            bool unique = true;
             int value = local_col[i * board.rows_count + j];
 
-            for (k = 0; k < board.rows_count; k++) {
-                if (j != k && value == local_col[i * board.rows_count + k]) {
-                    unique = false;
-                    break;
-                }
-            }
-
-            if (unique)
+            if (col_occurrences(board, first_col + i, value, &positions) == 1)
                 local_col_solution[i * board.rows_count + j] = WHITE; // If the value is unique, mark it as white
             else
                 local_col_solution[i * board.rows_count + j] = UNKNOWN;
@@ -77,12 +72,9 @@ Board mpi_uniqueness_rule(Board board, int rank, int size, MPI_Comm PRUNING_COMM
     mpi_gather_board(board, rank, local_row_solution, counts_send_row, displs_send_row, &row_solution, PRUNING_COMM);
     mpi_gather_board(board, rank, local_col_solution, counts_send_col, displs_send_col, &col_solution, PRUNING_COMM);
 
-    Board row_board = (Board) { board.grid, board.rows_count, board.cols_count, row_solution };
-    Board col_board = transpose((Board) { board.grid, board.rows_count, board.cols_count, col_solution });
-
-    Board solution = combine_boards(row_board, col_board, true, rank, "Uniqueness Rule", PRUNING_COMM);
+    Board solution = mpi_merge_lines(board, row_solution, col_solution, true, rank, "Uniqueness Rule", PRUNING_COMM);
 
-    free_memory((int *[]){local_row, counts_send_row, displs_send_row, local_col, counts_send_col, displs_send_col, row_solution, col_solution});
+    free_memory((int *[]){local_row, counts_send_row, displs_send_row, local_col, counts_send_col, displs_send_col, col_solution});
 
     return solution;
 }
@@ -107,77 +99,72 @@ Board mpi_sandwich_rules(Board board, int rank, int size, MPI_Comm PRUNING_COMM)
     int *local_col, *counts_send_col, *displs_send_col;
     mpi_scatter_board(board, rank, size, COLS, BOARD, &local_col, &counts_send_col, &displs_send_col, PRUNING_COMM);
 
-    int i, j;
     int local_row_solution[counts_send_row[rank]];
     int local_col_solution[counts_send_col[rank]];
 
     memset(local_row_solution, UNKNOWN, counts_send_row[rank] * sizeof(int));
     memset(local_col_solution, UNKNOWN, counts_send_col[rank] * sizeof(int));
 
-    // For each local row, check if triplet values are present
-    for (i = 0; i < (counts_send_row[rank] / board.cols_count); i++) {
-        for (j = 0; j < board.cols_count; j++) {
-            if (j < board.cols_count - 2) {
-                int value1 = local_row[i * board.cols_count + j];
-                int value2 = local_row[i * board.cols_count + j + 1];
-                int value3 = local_row[i * board.cols_count + j + 2];
-
-                if (value1 == value2 && value2 == value3) {
-                    local_row_solution[i * board.cols_count + j] = BLACK;
-                    local_row_solution[i * board.cols_count + j + 1] = WHITE;
-                    local_row_solution[i * board.cols_count + j + 2] = BLACK;
-
-                    if (j - 1 >= 0) local_col_solution[i * board.rows_count + j - 1] = WHITE;
-                    if (j + 3 < board.rows_count) local_col_solution[i * board.rows_count + j + 3] = WHITE;
-
-                } else if (value1 != value2 && value1 == value3) {
-                    local_row_solution[i * board.cols_count + j] = UNKNOWN;
-                    local_row_solution[i * board.cols_count + j + 1] = WHITE;
-                    local_row_solution[i * board.cols_count + j + 2] = UNKNOWN;
-                } 
-            }
-        }
-    }
-
-    // For each local column, check if triplet values are present
-    for (i = 0; i < (counts_send_col[rank] / board.rows_count); i++) {
-        for (j = 0; j < board.rows_count; j++) {
-            if (j < board.rows_count - 2) {
-                int value1 = local_col[i * board.rows_count + j];
-                int value2 = local_col[i * board.rows_count + j + 1];
-                int value3 = local_col[i * board.rows_count + j + 2];
+    // Match the line patterns on each local row and column (see line_patterns)
+    PatternRule rules[PATTERN_MAX_RULES];
+    int rules_count = line_patterns(rules);
 
-                if (value1 == value2 && value2 == value3) {
-                    local_col_solution[i * board.rows_count + j] = BLACK;
-                    local_col_solution[i * board.rows_count + j + 1] = WHITE;
-                    local_col_solution[i * board.rows_count + j + 2] = BLACK;
+    int local_conflicts = match_line_patterns(local_row, local_row_solution, counts_send_row[rank] / board.cols_count, board.cols_count, rules, rules_count);
+    local_conflicts += match_line_patterns(local_col, local_col_solution, counts_send_col[rank] / board.rows_count, board.rows_count, rules, rules_count);
 
-                    if (j - 1 >= 0) local_col_solution[i * board.rows_count + j - 1] = WHITE;
-                    if (j + 3 < board.rows_count) local_col_solution[i * board.rows_count + j + 3] = WHITE;
+    int conflicts;
+    MPI_Allreduce(&local_conflicts, &conflicts, 1, MPI_INT, MPI_SUM, PRUNING_COMM);
 
-                } else if (value1 != value2 && value1 == value3) {
-                    local_col_solution[i * board.rows_count + j] = UNKNOWN;
-                    local_col_solution[i * board.rows_count + j + 1] = WHITE;
-                    local_col_solution[i * board.rows_count + j + 2] = UNKNOWN;
-                }
-            }
-        }
+    if (conflicts > 0) {
+        if (rank == MANAGER_RANK) printf("[ERROR] The board has no solution, %d cells of the Sandwich Rules are both white and black\n", conflicts);
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
     }
 
     int *row_solution, *col_solution;
     mpi_gather_board(board, rank, local_row_solution, counts_send_row, displs_send_row, &row_solution, PRUNING_COMM);
     mpi_gather_board(board, rank, local_col_solution, counts_send_col, displs_send_col, &col_solution, PRUNING_COMM);
 
-    Board row_board = { board.grid, board.rows_count, board.cols_count, row_solution };
-    Board col_board = transpose((Board) { board.grid, board.rows_count, board.cols_count, col_solution });
-
-    Board solution = combine_boards(row_board, col_board, false, rank, "Sandwich Rules", PRUNING_COMM);
+    Board solution = mpi_merge_lines(board, row_solution, col_solution, false, rank, "Sandwich Rules", PRUNING_COMM);
     
-    free_memory((int *[]){local_row, counts_send_row, displs_send_row, local_col, counts_send_col, displs_send_col, row_solution, col_solution});
+    free_memory((int *[]){local_row, counts_send_row, displs_send_row, local_col, counts_send_col, displs_send_col, col_solution});
 
     return solution;
 }
 
+int match_line_patterns(int *lines, int *solution, int lines_count, int length, PatternRule *rules, int rules_count) {
+
+    /*
+        This function is responsible for matching the compiled rules on a set of lines stored one after the other. The window of a rule
+        starts one cell before each cell of the line (see line_patterns), the values outside of the line are 0.
+        It returns the number of conflicting deductions.
+    */
+
+    /*
+        Parameters:
+            lines: the values of the lines, length values per line
+            solution: the solution of the lines the deductions are written into
+            lines_count: the number of lines
+            length: the number of cells of each line
+            rules: the compiled rules
+            rules_count: the number of rules
+    */
+
+    int line, position, k, conflicts = 0;
+    int window[PATTERN_MAX_CELLS], window_cells[PATTERN_MAX_CELLS];
+
+    for (line = 0; line < lines_count; line++) {
+        for (position = 0; position < length; position++) {
+            for (k = 0; k < PATTERN_MAX_CELLS; k++) {
+                int window_position = position - 1 + k;
+                window_cells[k] = line * length + window_position;
+                window[k] = window_position >= 0 && window_position < length ? lines[window_cells[k]] : 0;
+            }
+            conflicts += apply_patterns(rules, rules_count, window, window_cells, solution);
+        }
+    }
+    return conflicts;
+}
+
 Board mpi_pair_isolation(Board board, int rank, int size, MPI_Comm PRUNING_COMM) {
 
     /*
@@ -194,13 +181,16 @@ Board mpi_pair_isolation(Board board, int rank, int size, MPI_Comm PRUNING_COMM)
     int *local_col, *counts_send_col, *displs_send_col;
     mpi_scatter_board(board, rank, size, COLS, BOARD, &local_col, &counts_send_col, &displs_send_col, PRUNING_COMM);
 
-    int i, j, k;
+    int i, j, k, occurrence, count;
     int local_row_solution[counts_send_row[rank]];
     int local_col_solution[counts_send_col[rank]];
 
     memset(local_row_solution, UNKNOWN, counts_send_row[rank] * sizeof(int));
     memset(local_col_solution, UNKNOWN, counts_send_col[rank] * sizeof(int));
 
+    int first_row = displs_send_row[rank] / board.cols_count, first_col = displs_send_col[rank] / board.rows_count;
+    const int *positions;
+
     // For each local row, check if there are pairs of values
     for (i = 0; i < (counts_send_row[rank] / board.cols_count); i++) {
         for (j = 0; j < board.cols_count; j++) {
@@ -211,15 +201,16 @@ Board mpi_pair_isolation(Board board, int rank, int size, MPI_Comm PRUNING_COMM)
                 if (value1 == value2) {
                     // Found a pair of values next to each other, mark all the other single values as black
 
-                    for (k = 0; k < board.cols_count; k++) {
-                        int single = local_row[i * board.cols_count + k];
+                    count = row_occurrences(board, first_row + i, value1, &positions);
+                    for (occurrence = 0; occurrence < count; occurrence++) {
                         bool isolated = true;
-                        
-                        if (k != j && k != j + 1 && single == value1) {
 
-                            // Check if the value3 is isolated
-                            if (k - 1 >= 0 && local_row[i * board.cols_count + k - 1] == single) isolated = false;
-                            if (k + 1 < board.cols_count && local_row[i * board.cols_count + k + 1] == single) isolated = false;
+                        k = positions[occurrence];
+                        if (k != j && k != j + 1) {
+
+                            // Check if the value is isolated
+                            if (k - 1 >= 0 && local_row[i * board.cols_count + k - 1] == value1) isolated = false;
+                            if (k + 1 < board.cols_count && local_row[i * board.cols_count + k + 1] == value1) isolated = false;
 
                             if (isolated) {
                                 local_row_solution[i * board.cols_count + k] = BLACK;
@@ -244,15 +235,16 @@ Board mpi_pair_isolation(Board board, int rank, int size, MPI_Comm PRUNING_COMM)
                 if (value1 == value2) {
                     // Found a pair of values next to each other, mark all the other single values as black
 
-                    for (k = 0; k < board.rows_count; k++) {
-                        int single = local_col[i * board.rows_count + k];
+                    count = col_occurrences(board, first_col + i, value1, &positions);
+                    for (occurrence = 0; occurrence < count; occurrence++) {
                         bool isolated = true;
-                        
-                        if (k != j && k != j + 1 && single == value1) {
 
-                            // Check if the value3 is isolated
-                            if (k - 1 >= 0 && local_col[i * board.rows_count + k - 1] == single) isolated = false;
-                            if (k + 1 < board.rows_count && local_col[i * board.rows_count + k + 1] == single) isolated = false;
+                        k = positions[occurrence];
+                        if (k != j && k != j + 1) {
+
+                            // Check if the value is isolated
+                            if (k - 1 >= 0 && local_col[i * board.rows_count + k - 1] == value1) isolated = false;
+                            if (k + 1 < board.rows_count && local_col[i * board.rows_count + k + 1] == value1) isolated = false;
 
                             if (isolated) {
                                 local_col_solution[i * board.rows_count + k] = BLACK;
@@ -271,12 +263,9 @@ Board mpi_pair_isolation(Board board, int rank, int size, MPI_Comm PRUNING_COMM)
     mpi_gather_board(board, rank, local_row_solution, counts_send_row, displs_send_row, &row_solution, PRUNING_COMM);
     mpi_gather_board(board, rank, local_col_solution, counts_send_col, displs_send_col, &col_solution, PRUNING_COMM);
 
-    Board row_board = { board.grid, board.rows_count, board.cols_count, row_solution };
-    Board col_board = transpose((Board) { board.grid, board.rows_count, board.cols_count, col_solution });
-
-    Board solution = combine_boards(row_board, col_board, false, rank, "Pair Isolation", PRUNING_COMM);
+    Board solution = mpi_merge_lines(board, row_solution, col_solution, false, rank, "Pair Isolation", PRUNING_COMM);
     
-    free_memory((int *[]){local_row, counts_send_row, displs_send_row, local_col, counts_send_col, displs_send_col, row_solution, col_solution});
+    free_memory((int *[]){local_row, counts_send_row, displs_send_row, local_col, counts_send_col, displs_send_col, col_solution});
 
     return solution;
 }
@@ -297,13 +286,16 @@ Board mpi_flanked_isolation(Board board, int rank, int size, MPI_Comm PRUNING_CO
     int *local_col, *counts_send_col, *displs_send_col;
     mpi_scatter_board(board, rank, size, COLS, BOARD, &local_col, &counts_send_col, &displs_send_col, PRUNING_COMM);
 
-    int i, j, k;
+    int i, j, k, occurrence, count1, count2;
     int local_row_solution[counts_send_row[rank]];
     int local_col_solution[counts_send_col[rank]];
 
     memset(local_row_solution, UNKNOWN, counts_send_row[rank] * sizeof(int));
     memset(local_col_solution, UNKNOWN, counts_send_col[rank] * sizeof(int));
 
+    int first_row = displs_send_row[rank] / board.cols_count, first_col = displs_send_col[rank] / board.rows_count;
+    const int *positions1, *positions2;
+
     // For each local row, check if there is a flanked pair
     for (i = 0; i < (counts_send_row[rank] / board.cols_count); i++) {
         for (j = 0; j < board.cols_count; j++) {
@@ -315,9 +307,11 @@ Board mpi_flanked_isolation(Board board, int rank, int size, MPI_Comm PRUNING_CO
                 int value4 = local_row[i * board.cols_count + j + 3];
 
                 if (value1 == value4 && value2 == value3 && value1 != value2) {
-                    for (k = 0; k < board.cols_count; k++) {
-                        int single = local_row[i * board.cols_count + k];
-                        if (k != j && k != j + 1 && k != j + 2 && k != j + 3 && (single == value1 || single == value2)) {
+                    count1 = row_occurrences(board, first_row + i, value1, &positions1);
+                    count2 = row_occurrences(board, first_row + i, value2, &positions2);
+                    for (occurrence = 0; occurrence < count1 + count2; occurrence++) {
+                        k = occurrence < count1 ? positions1[occurrence] : positions2[occurrence - count1];
+                        if (k < j || k > j + 3) {
                             local_row_solution[i * board.cols_count + k] = BLACK;
 
                             if (k - 1 >= 0) local_row_solution[i * board.cols_count + k - 1] = WHITE;
@@ -340,9 +334,11 @@ Board mpi_flanked_isolation(Board board, int rank, int size, MPI_Comm PRUNING_CO
                 int value4 = local_col[i * board.rows_count + j + 3];
 
                 if (value1 == value4 && value2 == value3 && value1 != value2) {
-                    for (k = 0; k < board.rows_count; k++) {
-                        int single = local_col[i * board.rows_count + k];
-                        if (k != j && k != j + 1 && k != j + 2 && k != j + 3 && (single == value1 || single == value2)) {
+                    count1 = col_occurrences(board, first_col + i, value1, &positions1);
+                    count2 = col_occurrences(board, first_col + i, value2, &positions2);
+                    for (occurrence = 0; occurrence < count1 + count2; occurrence++) {
+                        k = occurrence < count1 ? positions1[occurrence] : positions2[occurrence - count1];
+                        if (k < j || k > j + 3) {
                             local_col_solution[i * board.rows_count + k] = BLACK;
 
                             if (k - 1 >= 0) local_col_solution[i * board.rows_count + k - 1] = WHITE;
@@ -358,12 +354,9 @@ Board mpi_flanked_isolation(Board board, int rank, int size, MPI_Comm PRUNING_CO
     mpi_gather_board(board, rank, local_row_solution, counts_send_row, displs_send_row, &row_solution, PRUNING_COMM);
     mpi_gather_board(board, rank, local_col_solution, counts_send_col, displs_send_col, &col_solution, PRUNING_COMM);
 
-    Board row_board = { board.grid, board.rows_count, board.cols_count, row_solution };
-    Board col_board = transpose((Board) { board.grid, board.rows_count, board.cols_count, col_solution });
-
-    Board solution = combine_boards(row_board, col_board, false, rank, "Flanked Isolation", PRUNING_COMM);
+    Board solution = mpi_merge_lines(board, row_solution, col_solution, false, rank, "Flanked Isolation", PRUNING_COMM);
 
-    free_memory((int *[]){local_row, counts_send_row, displs_send_row, local_col, counts_send_col, displs_send_col, row_solution, col_solution});
+    free_memory((int *[]){local_row, counts_send_row, displs_send_row, local_col, counts_send_col, displs_send_col, col_solution});
 
     return solution;
 }
@@ -378,115 +371,46 @@ void compute_corner(Board board, int x, int y, CornerType corner_type, int **loc
     memset(*local_corner_solution, UNKNOWN, board.rows_count * board.cols_count * sizeof(int));
 
     /*
-        Get the values of the corner cells based on the corner indexes (x, y):
-        1) x --> top left 
-        2) x + 1 --> top right
-        3) y --> bottom left
-        4) y + 1 --> bottom right
+        Get the cells of the corner based on the corner indexes (x, y), the top left and bottom left cells of the 2x2 block, and orient them
+        as seen from the top left corner (see corner_patterns):
+        1) the corner cell
+        2) its neighbour on the row
+        3) its neighbour on the column
+        4) the diagonal cell
     */
 
-    int top_left = board.grid[x];
-    int top_right = board.grid[x + 1];
-    int bottom_left = board.grid[y];
-    int bottom_right = board.grid[y + 1];
-    
-    /*
-        Triple Corner case: if you have a corner with three similar numbers, mark the angle cell as black
-    */
+    int corner_cells[4][4] = {
+        { x, x + 1, y, y + 1 },     // TOP_LEFT
+        { x + 1, x, y + 1, y },     // TOP_RIGHT
+        { y, y + 1, x, x + 1 },     // BOTTOM_LEFT
+        { y + 1, y, x + 1, x }      // BOTTOM_RIGHT
+    };
 
-    switch (corner_type) {
-        case TOP_LEFT:
-        case BOTTOM_RIGHT:
-            if (top_left == top_right && top_left == bottom_left) {
-                (*local_corner_solution)[x] = BLACK;
-                (*local_corner_solution)[x + 1] = WHITE;
-                (*local_corner_solution)[y] = WHITE;
-
-            } else if (bottom_right == top_right && bottom_right == bottom_left) {
-                (*local_corner_solution)[y + 1] = BLACK;
-                (*local_corner_solution)[y] = WHITE;
-                (*local_corner_solution)[x + 1] = WHITE;
-            }
-            break;
-        
-        case TOP_RIGHT:
-        case BOTTOM_LEFT:
-            if (top_left == top_right && top_right == bottom_right) {
-                (*local_corner_solution)[x + 1] = BLACK;
-                (*local_corner_solution)[x] = WHITE;
-                (*local_corner_solution)[y + 1] = WHITE;
-
-            } else if (bottom_left == top_left && bottom_left == bottom_right) {
-                (*local_corner_solution)[y] = BLACK;
-                (*local_corner_solution)[x] = WHITE;
-                (*local_corner_solution)[y + 1] = WHITE;
-            }
-            break;
-    }
+    int *cells = corner_cells[corner_type];
+    int values[PATTERN_MAX_CELLS] = { 0 };
+    int i, conflicts;
 
-    
-    /*
-        Pair Corner case: if you have a corner with two similar numbers, you can mark a single as white for all combinations
-    */
+    PatternRule rules[PATTERN_MAX_RULES];
+    int rules_count = corner_patterns(rules);
 
-    switch (corner_type) {
-        case TOP_LEFT:
-        case BOTTOM_RIGHT:
-            if (top_left == top_right) (*local_corner_solution)[y] = WHITE;
-            else if (top_left == bottom_left) (*local_corner_solution)[x + 1] = WHITE;
-            else if (bottom_left == bottom_right) (*local_corner_solution)[x + 1] = WHITE;
-            else if (top_right == bottom_right) (*local_corner_solution)[y] = WHITE;
-            break;
-        case TOP_RIGHT:
-        case BOTTOM_LEFT:
-            if (top_left == top_right) (*local_corner_solution)[y + 1] = WHITE;
-            else if (top_right == bottom_right) (*local_corner_solution)[x] = WHITE;
-            else if (bottom_left == bottom_right) (*local_corner_solution)[x] = WHITE;
-            else if (top_left == bottom_left) (*local_corner_solution)[y + 1] = WHITE;
-            break;
-    }
+    for (i = 0; i < 4; i++) values[i] = board.grid[cells[i]];
 
     /*
-        Quad Corner case: if you have a corner with four similar numbers, the diagonal cells must be black
+        Triple, Pair and Quad Corner cases, matched by the corner patterns
     */
-    
-    if ((top_left == top_right && top_left == bottom_left && top_left == bottom_right) ||
-        (top_right == bottom_right && top_left == bottom_left) ||
-        (top_left == top_right && bottom_left == bottom_right)) {
-            
-            switch (corner_type) {        
-                case TOP_LEFT:
-                case BOTTOM_LEFT:
-                    (*local_corner_solution)[x] = BLACK;
-                    (*local_corner_solution)[x + 1] = WHITE;
-                    (*local_corner_solution)[y] = WHITE;
-                    (*local_corner_solution)[y + 1] = BLACK;
-                    break;
-                case TOP_RIGHT:
-                case BOTTOM_RIGHT:
-                    (*local_corner_solution)[x] = WHITE;
-                    (*local_corner_solution)[x + 1] = BLACK;
-                    (*local_corner_solution)[y] = BLACK;
-                    (*local_corner_solution)[y + 1] = WHITE;
-                    break;
-            }
-        }
-    
+
+    conflicts = apply_patterns(rules, rules_count, values, cells, *local_corner_solution);
+
     /*
         Corner Close: If you have a black in the corner, the other must be white
     */
 
-    switch (corner_type) { 
-        case TOP_LEFT:
-        case BOTTOM_RIGHT:
-            if (board.solution[x + 1] == BLACK) (*local_corner_solution)[y] = WHITE;
-            else if (board.solution[y] == BLACK) (*local_corner_solution)[x + 1] = WHITE;
-            break;
-        case TOP_RIGHT:
-        case BOTTOM_LEFT:
-            if (board.solution[x] == BLACK) (*local_corner_solution)[y + 1] = WHITE;
-            else if (board.solution[y + 1] == BLACK) (*local_corner_solution)[x] = WHITE;
-            break;
+    if (board.solution[cells[1]] == BLACK) conflicts += mark_cell(*local_corner_solution, cells[2], WHITE);
+    else if (board.solution[cells[2]] == BLACK) conflicts += mark_cell(*local_corner_solution, cells[1], WHITE);
+
+    if (conflicts > 0) {
+        printf("[ERROR] The board has no solution, %d cells of a corner are both white and black\n", conflicts);
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
     }
 }
 
@@ -599,21 +523,29 @@ Board mpi_corner_cases(Board board, int rank, int size, MPI_Comm PRUNING_COMM) {
     }
 
     /*
-        Combine the partial solutions
+        Combine the partial solutions in place on the manager, and broadcast the merged solution
     */
 
-    int rows = board.rows_count;
-    int cols = board.cols_count;
+    int cells_count = board.rows_count * board.cols_count;
+    int corner, conflicts = 0;
+
+    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(cells_count * sizeof(int)), board.occurrences };
 
-    Board top_left_board = { board.grid, board.rows_count, board.cols_count, solutions };
-    Board top_right_board = { board.grid, board.rows_count, board.cols_count, solutions + rows * cols };
-    Board bottom_left_board = { board.grid, board.rows_count, board.cols_count, solutions + 2 * rows * cols };
-    Board bottom_right_board = { board.grid, board.rows_count, board.cols_count, solutions + 3 * rows * cols };
+    if (rank == MANAGER_RANK) {
+        memcpy(solution.solution, solutions, cells_count * sizeof(int));
+        for (corner = 1; corner < 4; corner++)
+            conflicts += merge_solutions(solution.solution, solutions + corner * cells_count, cells_count, false);
 
-    Board top_corners_board = combine_boards(top_left_board, top_right_board, false, rank, "Top Corner Cases", PRUNING_COMM);
-    Board bottom_corners_board = combine_boards(bottom_left_board, bottom_right_board, false, rank, "Bottom Corner Cases", PRUNING_COMM);
+        free(solutions);
+    }
 
-    Board solution = combine_boards(top_corners_board, bottom_corners_board, false, rank, "Corner Cases", PRUNING_COMM);
+    MPI_Bcast(&conflicts, 1, MPI_INT, MANAGER_RANK, PRUNING_COMM);
+    if (conflicts > 0) {
+        if (rank == MANAGER_RANK) printf("[ERROR] The board has no solution, %d cells of the Corner Cases are both white and black\n", conflicts);
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
+
+    MPI_Bcast(solution.solution, cells_count, MPI_INT, MANAGER_RANK, PRUNING_COMM);
 
     /*
         Destroy the temporary communicators, compute the final solution and broadcast it to all processes
@@ -625,143 +557,157 @@ Board mpi_corner_cases(Board board, int rank, int size, MPI_Comm PRUNING_COMM) {
     return solution;
 }
 
-Board mpi_set_white(Board board, int rank, int size, MPI_Comm PRUNING_COMM) {
-    
+Board mpi_two_sat_rule(Board board, int rank, int size, MPI_Comm PRUNING_COMM) {
+
     /*
         RULE DESCRIPTION:
         
-        When you have whited a cell, you can mark all the other cells with the same number in the row or column as black
-        
-        e.g. Suppose a whited 3. Then 2 O ... 3 --> 2 O ... X
+        The first two rules only bind pairs of cells: two adjacent cells cannot both be black, and two cells with the same value
+        in a row or column cannot both be white. Together with the cells already known they form a 2-SAT problem, solved on its
+        implication graph: a cell is marked when one of its states implies the other one (see two_sat.c).
+        The implication graph spans the whole board, so the manager solves it and broadcasts the marked cells to the other workers.
+        This subsumes the sandwich rules and the set white/black propagation, and proves at once when the board cannot be solved.
+
+        e.g. 2 3 2 --> 2 O 2 (a black 3 would force both the 2s to white)
     */
 
-    int *local_row, *counts_send_row, *displs_send_row;
-    mpi_scatter_board(board, rank, size, ROWS, SOLUTION, &local_row, &counts_send_row, &displs_send_row, PRUNING_COMM);
+    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)), board.occurrences };
 
-    int *local_col, *counts_send_col, *displs_send_col;
-    mpi_scatter_board(board, rank, size, COLS, SOLUTION, &local_col, &counts_send_col, &displs_send_col, PRUNING_COMM);
+    int satisfiable = 1;
+    if (rank == MANAGER_RANK) satisfiable = solve_two_sat(board, solution.solution);
 
-    int i, j, k;
-    int local_row_solution[counts_send_row[rank]];
-    int local_col_solution[counts_send_col[rank]];
+    MPI_Bcast(&satisfiable, 1, MPI_INT, MANAGER_RANK, PRUNING_COMM);
+    if (!satisfiable) {
+        if (rank == MANAGER_RANK) printf("[ERROR] The board has no solution, the first two rules cannot be satisfied\n");
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
 
-    memset(local_row_solution, UNKNOWN, counts_send_row[rank] * sizeof(int));
-    memset(local_col_solution, UNKNOWN, counts_send_col[rank] * sizeof(int));
+    MPI_Bcast(solution.solution, board.rows_count * board.cols_count, MPI_INT, MANAGER_RANK, PRUNING_COMM);
 
-    int starting_index = 0;
+    return solution;
+}
 
-    for (i = 0; i < rank; i++)
-        starting_index += counts_send_row[i];
-    
-    // For each local row, check if there is a white cell
-    int rows_count = (counts_send_row[rank] / board.cols_count);
-    for (i = 0; i < rows_count; i++) {
-        int grid_row_index = starting_index + i * board.cols_count;
-        for (j = 0; j < board.cols_count; j++) {
-            if (local_row[i * board.cols_count + j] == WHITE) {
-                int value = board.grid[grid_row_index + j];
+Board mpi_articulation_point_rule(Board board, int rank, int size, MPI_Comm PRUNING_COMM) {
+
+    /*
+        RULE DESCRIPTION:
+        
+        The white cells must stay connected. In the graph of the non-black cells, an unknown cell whose removal would split its
+        component (an articulation point, see articulation.c) cannot be black, so it must be white.
+        The depth-first search spans the whole board, so the manager runs it and broadcasts the marked cells to the other workers.
 
-                for (k = 0; k < board.cols_count; k++) {
-                    if (board.grid[grid_row_index + k] == value && k != j) {
-                        local_row_solution[i * board.cols_count + k] = BLACK;
+        e.g. | O ?      | O O
+             | X    --> | X
+    */
 
-                        if (k - 1 >= 0) local_row_solution[i * board.cols_count + k - 1] = WHITE;
-                        if (k + 1 < board.cols_count) local_row_solution[i * board.cols_count + k + 1] = WHITE;
-                    }
-                }
-            }
-        }
+    int i, cells_count = board.rows_count * board.cols_count;
+
+    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(cells_count * sizeof(int)), board.occurrences };
+
+    if (rank == MANAGER_RANK) {
+        bool *articulation = (bool *) malloc(cells_count * sizeof(bool));
+        find_articulation_points(board, articulation);
+        for (i = 0; i < cells_count; i++)
+            solution.solution[i] = board.solution[i] == UNKNOWN && articulation[i] ? WHITE : UNKNOWN;
+        free(articulation);
     }
 
-    Board TBoard = transpose(board);
+    MPI_Bcast(solution.solution, cells_count, MPI_INT, MANAGER_RANK, PRUNING_COMM);
 
-    // For each local column, check if triplet values are present
-    int cols_count = (counts_send_col[rank] / board.rows_count);
-    for (i = 0; i < cols_count; i++) {
-        int grid_col_index = starting_index + i * board.rows_count;
-        for (j = 0; j < board.rows_count; j++) {
-            if (local_col[i * board.rows_count + j] == WHITE) {
-                int value = TBoard.grid[grid_col_index + j];
+    return solution;
+}
 
-                for (k = 0; k < board.rows_count; k++) {
-                    if (TBoard.grid[grid_col_index + k] == value && k != j) {
-                        local_col_solution[i * board.rows_count + k] = BLACK;
+Board mpi_fixed_point_propagation(Board board, int rank, int size, MPI_Comm PRUNING_COMM) {
 
-                        if (k - 1 >= 0) local_col_solution[i * board.rows_count + k - 1] = WHITE;
-                        if (k + 1 < board.rows_count) local_col_solution[i * board.rows_count + k + 1] = WHITE;
-                    }
-                }
-            }
-        }
-    }
+    /*
+        RULE DESCRIPTION:
+        
+        Propagate the known cells until nothing changes, with a queue of the newly decided cells (see propagate_known_cells):
+        a black cell whitens its neighbours, a white cell blackens the cells with its value in its row and column, and a decided cell
+        is queued in turn. Once the queue is drained, the unknown articulation points of the non-black cells are whitened and queued.
+        Each cell is visited once, when it is decided, so the manager propagates alone and broadcasts the solution to the other workers,
+        instead of rescanning the whole board until it stops changing.
 
-    int *row_solution, *col_solution;
-    mpi_gather_board(board, rank, local_row_solution, counts_send_row, displs_send_row, &row_solution, PRUNING_COMM);
-    mpi_gather_board(board, rank, local_col_solution, counts_send_col, displs_send_col, &col_solution, PRUNING_COMM);
+        e.g. 2 O ... 2 --> 2 O ... X --> 2 O ... O X O
+    */
 
-    Board row_board = { board.grid, board.rows_count, board.cols_count, row_solution }; 
-    Board col_board = transpose((Board) { board.grid, board.rows_count, board.cols_count, col_solution });
+    int consistent = 1, changed_count = 0;
 
-    Board solution = combine_boards(row_board, col_board, false, rank, "Set White", PRUNING_COMM);
-    
-    free_memory((int *[]){local_row, counts_send_row, displs_send_row, local_col, counts_send_col, displs_send_col, row_solution, col_solution});
+    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)), board.occurrences };
+
+    if (rank == MANAGER_RANK) consistent = propagate_known_cells(board, solution.solution, &changed_count);
+
+    MPI_Bcast(&consistent, 1, MPI_INT, MANAGER_RANK, PRUNING_COMM);
+    if (!consistent) {
+        if (rank == MANAGER_RANK) printf("[ERROR] The board has no solution, the propagation of the known cells leads to a conflict\n");
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
+
+    if (DEBUG && rank == MANAGER_RANK) printf("[INFO] The propagation decided %d cells\n", changed_count);
+
+    MPI_Bcast(solution.solution, board.rows_count * board.cols_count, MPI_INT, MANAGER_RANK, PRUNING_COMM);
 
     return solution;
 }
 
-Board mpi_set_black(Board board, int rank, int size, MPI_Comm PRUNING_COMM) {
-    
+Board mpi_failed_literal_probing(Board board, int rank, int size, MPI_Comm PROBING_COMM) {
+
     /*
         RULE DESCRIPTION:
         
-        When you have marked a black cell, all the cells around it must be white.
+        Try both states on each unknown cell and propagate them with the rules of the search (see probing.c).
+        If a state leads to a conflict, or a black cell would split the white cells, the cell takes the other state.
+        The cells taking the same state in both propagations are marked too. The probes are independent, so each process
+        probes one unknown cell every size ones on its own block, the marked cells are merged with a bitwise or and applied by every process,
+        then the probing is repeated until nothing changes.
 
-        e.g. 2 X 2 --> O X O
+        e.g. A corner cell with a black neighbour on its right: a black cell below it would isolate the corner, so it is marked white
     */
 
-    int *local_row, *counts_send_row, *displs_send_row;
-    mpi_scatter_board(board, rank, size, ROWS, SOLUTION, &local_row, &counts_send_row, &displs_send_row, PRUNING_COMM);
+    int i, cells_count = board.rows_count * board.cols_count, fixed_count = 1, unknowns_count;
+    int consistent = 1;
 
-    int *local_col, *counts_send_col, *displs_send_col;
-    mpi_scatter_board(board, rank, size, COLS, SOLUTION, &local_col, &counts_send_col, &displs_send_col, PRUNING_COMM);
+    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(cells_count * sizeof(int)), board.occurrences };
+    memcpy(solution.solution, board.solution, cells_count * sizeof(int));
 
-    int i, j;
-    int local_row_solution[counts_send_row[rank]];
-    int local_col_solution[counts_send_col[rank]];
+    BCB board_block, block;
+    init_probe_block(solution, &board_block);
 
-    memset(local_row_solution, UNKNOWN, counts_send_row[rank] * sizeof(int));
-    memset(local_col_solution, UNKNOWN, counts_send_col[rank] * sizeof(int));
+    int *local_flags = (int *) malloc(cells_count * sizeof(int));
+    int *forced_flags = (int *) malloc(cells_count * sizeof(int));
+    int *probe_trail = (int *) malloc(cells_count * sizeof(int));
 
-    // For each local row, check if there is a white cell
-    for (i = 0; i < (counts_send_row[rank] / board.cols_count); i++) {
-        for (j = 0; j < board.cols_count; j++) {
-            if (local_row[i * board.cols_count + j] == BLACK) {                
-                if (j - 1 >= 0) local_row_solution[i * board.cols_count + j - 1] = WHITE;
-                if (j + 1 < board.cols_count) local_row_solution[i * board.cols_count + j + 1] = WHITE;
-            }
-        }
-    }
+    while (consistent && fixed_count > 0) {
+        memset(local_flags, 0, cells_count * sizeof(int));
+        init_probe_block(solution, &block);
 
-    // For each local column, check if triplet values are present
-    for (i = 0; i < (counts_send_col[rank] / board.rows_count); i++) {
-        for (j = 0; j < board.rows_count; j++) {
-            if (local_col[i * board.rows_count + j] == BLACK) {
-                if (j - 1 >= 0) local_col_solution[i * board.rows_count + j - 1] = WHITE;
-                if (j + 1 < board.rows_count) local_col_solution[i * board.rows_count + j + 1] = WHITE;
-            }
+        // The unknown cells are dealt round robin, so that every process gets cells from the whole board
+        unknowns_count = 0;
+        for (i = 0; i < cells_count; i++) {
+            if (block.solution[i] != UNKNOWN) continue;
+            if (unknowns_count++ % size != rank || local_flags[i] != 0) continue;
+            if (!probe_cell(solution, &block, i, probe_trail, local_flags))
+                consistent = 0;
         }
-    }
+        free_block(&block);
 
-    int *row_solution, *col_solution;
-    mpi_gather_board(board, rank, local_row_solution, counts_send_row, displs_send_row, &row_solution, PRUNING_COMM);
-    mpi_gather_board(board, rank, local_col_solution, counts_send_col, displs_send_col, &col_solution, PRUNING_COMM);
+        MPI_Allreduce(MPI_IN_PLACE, &consistent, 1, MPI_INT, MPI_LAND, PROBING_COMM);
+        MPI_Allreduce(local_flags, forced_flags, cells_count, MPI_INT, MPI_BOR, PROBING_COMM);
 
-    Board row_board = { board.grid, board.rows_count, board.cols_count, row_solution };
-    Board col_board = transpose((Board) { board.grid, board.rows_count, board.cols_count, col_solution });
+        if (consistent)
+            consistent = apply_forced_flags(solution, &board_block, forced_flags, &fixed_count);
+        memcpy(solution.solution, board_block.solution, cells_count * sizeof(int));
+    }
 
-    Board solution = combine_boards(row_board, col_board, false, rank, "Set Black", PRUNING_COMM);
+    if (!consistent) {
+        if (rank == MANAGER_RANK) printf("[ERROR] The board has no solution, every state of a cell leads to a conflict\n");
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
 
-    free_memory((int *[]){local_row, counts_send_row, displs_send_row, local_col, counts_send_col, displs_send_col, row_solution, col_solution});
+    free_block(&board_block);
+    free(local_flags);
+    free(forced_flags);
+    free(probe_trail);
 
     return solution;
 }
@@ -5,6 +5,7 @@
 
 #include "../include/utils.h"
 #include "../include/board.h"
+#include "../include/occurrences.h"
 
 void write_solution(Board board) {
 
@@ -138,6 +139,9 @@ void mpi_share_board(Board* board, int rank) {
 
     MPI_Bcast(board->grid, board->rows_count * board->cols_count, MPI_INT, MANAGER_RANK, MPI_COMM_WORLD);
     MPI_Bcast(board->solution, board->rows_count * board->cols_count, MPI_INT, MANAGER_RANK, MPI_COMM_WORLD);
+
+    // The occurrences only depend on the grid, so each process builds them once, the first time the board is shared
+    if (board->occurrences == NULL) board->occurrences = build_value_occurrences(*board);
 }
 
 void mpi_scatter_board(Board board, int rank, int size, ScatterType scatter_type, BoardType target_type, int **local_vector, int **counts_send, int **displs_send, MPI_Comm PRUNING_COMM) {
@@ -216,3 +220,148 @@ void mpi_gather_board(Board board, int rank, int *local_vector, int *counts_send
 
     MPI_Gatherv(local_vector, counts_send[rank], MPI_INT, *solution, counts_send, displs_send, MPI_INT, MANAGER_RANK, PRUNING_COMM);
 }
+
+SolverConfig read_config(int argc, char **argv) {
+
+    /*
+        Helper function to read the solver configuration from the optional command line arguments, given after the input file as --key=value.
+        The options not provided keep their default value.
+    */
+
+    /*
+        Parameters:
+            - argc: the number of command line arguments
+            - argv: the command line arguments
+    */
+
+    SolverConfig config = {
+        .engine = BACKTRACKING,
+        .branching = STATIC_ORDER,
+        .value_order = WHITE_FIRST,
+        .restarts = false,
+        .seed = 1,
+        .learning = true,
+        .portfolio = false,
+        .work_split = CUBES_SPLIT,
+        .share_nogoods = false
+    };
+
+    int i;
+    for (i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--engine=backtracking") == 0)
+            config.engine = BACKTRACKING;
+        else if (strcmp(argv[i], "--engine=rows") == 0)
+            config.engine = ROW_PATTERNS;
+        else if (strcmp(argv[i], "--engine=cdcl") == 0)
+            config.engine = CDCL;
+        else if (strcmp(argv[i], "--engine=frontier") == 0)
+            config.engine = FRONTIER;
+        else if (strcmp(argv[i], "--branching=static") == 0)
+            config.branching = STATIC_ORDER;
+        else if (strcmp(argv[i], "--branching=most-constrained") == 0)
+            config.branching = MOST_CONSTRAINED;
+        else if (strcmp(argv[i], "--branching=groups") == 0)
+            config.branching = DUPLICATE_GROUPS;
+        else if (strcmp(argv[i], "--value-order=white-first") == 0)
+            config.value_order = WHITE_FIRST;
+        else if (strcmp(argv[i], "--value-order=pressure") == 0)
+            config.value_order = CONFLICT_PRESSURE;
+        else if (strcmp(argv[i], "--restarts=on") == 0)
+            config.restarts = true;
+        else if (strcmp(argv[i], "--restarts=off") == 0)
+            config.restarts = false;
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            config.seed = (unsigned int) strtoul(argv[i] + 7, NULL, 10);
+        else if (strcmp(argv[i], "--learning=on") == 0)
+            config.learning = true;
+        else if (strcmp(argv[i], "--learning=off") == 0)
+            config.learning = false;
+        else if (strcmp(argv[i], "--portfolio=on") == 0)
+            config.portfolio = true;
+        else if (strcmp(argv[i], "--portfolio=off") == 0)
+            config.portfolio = false;
+        else if (strcmp(argv[i], "--split=spaces") == 0)
+            config.work_split = SPACES_SPLIT;
+        else if (strcmp(argv[i], "--split=cubes") == 0)
+            config.work_split = CUBES_SPLIT;
+        else if (strcmp(argv[i], "--share-nogoods=on") == 0)
+            config.share_nogoods = true;
+        else if (strcmp(argv[i], "--share-nogoods=off") == 0)
+            config.share_nogoods = false;
+        else {
+            printf("[ERROR] Unknown option %s\n", argv[i]);
+            exit(-1);
+        }
+    }
+
+    return config;
+}
+
+SolverConfig portfolio_config(SolverConfig config, int group) {
+
+    /*
+        Helper function to get the configuration of a group of the portfolio, a variant of the configuration read from the command line:
+            - group 0: the configuration read from the command line
+            - group 1: the most constrained cell first, trying black first on the cells under conflict pressure
+            - group 2: the restarts on a random order of the cells, with random phases
+            - group 3: the duplicate groups, with the chronological backtracking and no nogood propagation
+        The groups after the last one repeat the variants, with their own seed.
+    */
+
+    /*
+        Parameters:
+            - config: the configuration read from the command line
+            - group: the index of the group in the portfolio
+    */
+
+    if (group % PORTFOLIO_CONFIGS == 1) {
+        config.branching = MOST_CONSTRAINED;
+        config.value_order = CONFLICT_PRESSURE;
+        config.restarts = false;
+        config.learning = true;
+    } else if (group % PORTFOLIO_CONFIGS == 2) {
+        config.branching = STATIC_ORDER;
+        config.value_order = WHITE_FIRST;
+        config.restarts = true;
+        config.learning = true;
+    } else if (group % PORTFOLIO_CONFIGS == 3) {
+        config.branching = DUPLICATE_GROUPS;
+        config.value_order = WHITE_FIRST;
+        config.restarts = false;
+        config.learning = false;
+    }
+
+    config.seed += group;
+    return config;
+}
+
+int portfolio_groups_count(int members) {
+
+    /*
+        Helper function to get the number of groups of the portfolio, one per configuration unless there are fewer members.
+        The member m belongs to the group m % groups, and is the member m / groups of its group.
+    */
+
+    /*
+        Parameters:
+            - members: the number of members of the portfolio
+    */
+
+    return members < PORTFOLIO_CONFIGS ? members : PORTFOLIO_CONFIGS;
+}
+
+int portfolio_group_size(int members, int group) {
+
+    /*
+        Helper function to get the number of members of a group of the portfolio.
+    */
+
+    /*
+        Parameters:
+            - members: the number of members of the portfolio
+            - group: the index of the group
+    */
+
+    int groups = portfolio_groups_count(members);
+    return (members - group + groups - 1) / groups;
+}
@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/common.h"
+#include "../include/backtracking.h"
+#include "../include/black_chains.h"
+#include "../include/validation.h"
+
+#define BENCH_SECONDS_PER_SIZE 0.5      // Time spent validating the leaves of each size and kind
+#define BENCH_LEAVES 16                 // Number of leaves generated for each size and kind, validated in turn
+#define BENCH_BLACK_PERCENT 35          // Chance, in percent, that a cell drawn while generating a leaf is tried as black
+
+double elapsed_seconds(struct timespec start) {
+
+    /*
+        Helper function to get the seconds elapsed since the given time.
+    */
+
+    /*
+        Parameters:
+            - start: the starting time, from CLOCK_MONOTONIC
+    */
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+void generate_leaf(Board board, BCB *block, unsigned int seed, bool connected) {
+
+    /*
+        Generate a leaf of the board: the cells are drawn at random and made black when none of their neighbours is black.
+        A connected leaf also skips the black cells closing a diagonal chain, so its white cells stay connected,
+        while the other leaves are mostly split.
+    */
+
+    /*
+        Parameters:
+            - board: the board of the leaf, only its size is used
+            - block: the BCB filled with the leaf
+            - seed: the seed of the random draws
+            - connected: flag to keep the white cells connected
+    */
+
+    int cells_count = board.rows_count * board.cols_count;
+    int i, x, y, cell_index;
+    BlackChains chains;
+
+    block->solution = (CellState *) malloc(cells_count * sizeof(CellState));
+    block->solution_space_unknowns = (bool *) calloc(cells_count, sizeof(bool));
+    for (i = 0; i < cells_count; i++) block->solution[i] = WHITE;
+
+    init_black_chains(board, &chains);
+    srand(seed);
+
+    for (i = 0; i < cells_count; i++) {
+        cell_index = rand() % cells_count;
+        x = cell_index / board.cols_count;
+        y = cell_index % board.cols_count;
+
+        if (block->solution[cell_index] == BLACK || rand() % 100 >= BENCH_BLACK_PERCENT) continue;
+        if ((x > 0 && block->solution[cell_index - board.cols_count] == BLACK) || (x < board.rows_count - 1 && block->solution[cell_index + board.cols_count] == BLACK) ||
+            (y > 0 && block->solution[cell_index - 1] == BLACK) || (y < board.cols_count - 1 && block->solution[cell_index + 1] == BLACK)) continue;
+        if (connected && closes_black_chain(board, &chains, block->solution, x, y)) continue;
+
+        add_black_cell(board, &chains, block->solution, x, y);
+        block->solution[cell_index] = BLACK;
+    }
+
+    free_black_chains(&chains);
+    compute_block_state(board, block);
+}
+
+int main(int argc, char** argv) {
+
+    /*
+        Microbenchmark of the leaf validation: for each board size, check_hitori_conditions is called in turn on BENCH_LEAVES generated leaves
+        for BENCH_SECONDS_PER_SIZE seconds, first on connected leaves, then on mostly split ones, and the leaves validated per second are printed.
+        The values of the board are all the same, the validation only checks the connectivity of the white cells.
+        Usage: leaf_validation.out
+    */
+
+    int sizes[] = { 5, 10, 20, 30, 40, 50, 60 };
+    int sizes_count = sizeof(sizes) / sizeof(sizes[0]);
+    int s, i, leaf;
+
+    printf("%-8s %-10s %16s %12s %12s\n", "size", "leaves", "leaves/sec", "connected", "validated");
+
+    for (s = 0; s < sizes_count; s++) {
+        int n = sizes[s];
+        Board board = { (int *) malloc(n * n * sizeof(int)), n, n, NULL, NULL };
+        for (i = 0; i < n * n; i++) board.grid[i] = 1;
+
+        int connected;
+        for (connected = 1; connected >= 0; connected--) {
+            BCB leaves[BENCH_LEAVES];
+            long long validated = 0, connected_count = 0;
+            struct timespec start;
+
+            for (leaf = 0; leaf < BENCH_LEAVES; leaf++) generate_leaf(board, &leaves[leaf], 1000 * n + leaf, connected);
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            while (elapsed_seconds(start) < BENCH_SECONDS_PER_SIZE) {
+                for (i = 0; i < 100; i++, validated++)
+                    connected_count += check_hitori_conditions(board, &leaves[validated % BENCH_LEAVES]);
+            }
+            double time = elapsed_seconds(start);
+
+            char size_label[16];
+            snprintf(size_label, sizeof(size_label), "%dx%d", n, n);
+            printf("%-8s %-10s %16.0f %12lld %12lld\n", size_label, connected ? "connected" : "split", validated / time, connected_count, validated);
+
+            for (leaf = 0; leaf < BENCH_LEAVES; leaf++) free_block(&leaves[leaf]);
+        }
+
+        free(board.grid);
+    }
+
+    return 0;
+}
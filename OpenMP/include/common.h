@@ -2,11 +2,24 @@
 #define COMMON_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #define DEBUG 0
 #define INPUT_PATH "../test-cases/inputs/"
 #define MAX_BUFFER_SIZE 2048
 #define SOLUTION_SPACES 8
+#define MAX_ROW_PATTERNS 4096
+#define ROW_SEARCH_STEPS 4096
+#define CDCL_SEARCH_CONFLICTS 1024
+#define CDCL_RESTART_CONFLICTS 100
+#define CDCL_MAX_LEARNED 4096
+#define FRONTIER_MAX_LAYER_STATES 262144
+#define FRONTIER_MAX_STATES 8388608
+#define NOGOOD_CAPACITY 256
+#define NOGOOD_MAX_LITERALS 16
+#define RESTART_NODES 512
+#define PATTERN_MAX_CELLS 5
+#define PATTERN_MAX_RULES 16
 
 // Definition of the cell states for the hitori board
 typedef enum CellState {
@@ -35,18 +48,227 @@ typedef enum CornerType {
     BOTTOM_RIGHT = 3
 } CornerType;  
 
+// Pruning rule written as a pattern over a window of cells: when the values of the window follow the classes of the pattern, its cells take
+// the states of the pattern. The classes and the states are compiled into masks over the pairs of cells of the window, see compile_patterns
+typedef struct PatternRule {
+    char *name;                     // Name of the rule
+    char *classes;                  // Class of the value of each cell: the same letter for equal values, different letters for different values, '*' for any value
+    char *states;                   // State deduced for each cell: 'X' black, 'O' white, '.' none
+    int cells_count;                // Number of cells of the window
+    uint32_t equal_pairs;           // Pairs of cells whose values must be equal, bit i * PATTERN_MAX_CELLS + j for the cells i < j
+    uint32_t different_pairs;       // Pairs of cells whose values must be different
+    uint32_t required_cells;        // Cells that must be on the board, the cells with a letter
+} PatternRule;
+
+// Positions of each value in each row and column of the board, in CSR layout: the positions of a (line, value) pair are stored contiguously
+typedef struct ValueOccurrences {
+    int *row_offsets;               // Index in row_cols of the first cell of each (row, value) pair, indexed as [row * (cols_count + 1) + value], plus a final end
+    int *row_cols;                  // Columns of the cells of each row, grouped by value in increasing order
+    int *col_offsets;               // Index in col_rows of the first cell of each (column, value) pair, indexed as [col * (rows_count + 1) + value], plus a final end
+    int *col_rows;                  // Rows of the cells of each column, grouped by value in increasing order
+} ValueOccurrences;
+
 // Definition of the board structure
 typedef struct Board {
     int *grid;
     int rows_count;
     int cols_count;
     CellState *solution;
+    ValueOccurrences *occurrences;  // Built once per puzzle, shared by all the boards with the same grid
 } Board;
 
+// Definition of the branching heuristics of the backtracking search, STATIC_ORDER follows the unknown index, MOST_CONSTRAINED picks the unknown with the most same-value conflicts,
+// DUPLICATE_GROUPS branches on the groups of same-value unknowns in a row or column, choosing which member stays white or none of them
+typedef enum BranchingHeuristic {
+    STATIC_ORDER = 0,
+    MOST_CONSTRAINED = 1,
+    DUPLICATE_GROUPS = 2
+} BranchingHeuristic;
+
+// Definition of the value orders of the backtracking search, WHITE_FIRST always tries white first, CONFLICT_PRESSURE tries black first on cells with more conflicts than unknown neighbours
+typedef enum ValueOrder {
+    WHITE_FIRST = 0,
+    CONFLICT_PRESSURE = 1
+} ValueOrder;
+
+// Definition of the solver engines, BACKTRACKING decides the cells one at a time, ROW_PATTERNS chooses whole rows among their legal black masks,
+// CDCL learns clauses from the conflicts and adds the connectivity rule lazily as cut clauses, FRONTIER sweeps the cells with a dynamic programming over the frontier states
+typedef enum SolverEngine {
+    BACKTRACKING = 0,
+    ROW_PATTERNS = 1,
+    CDCL = 2,
+    FRONTIER = 3
+} SolverEngine;
+
+// Definition of the solver configuration, read from the optional command line arguments
+typedef struct SolverConfig {
+    SolverEngine engine;            // Engine used to search the solution (--engine=backtracking|rows|cdcl|frontier), the row patterns need at most 32 columns
+    BranchingHeuristic branching;   // Heuristic used to select the next cell to branch on (--branching=static|most-constrained|groups)
+    ValueOrder value_order;         // Order in which the states of the selected cell are tried (--value-order=white-first|pressure), groups always try white first
+    bool restarts;                  // Restarts of the backtracking search on a Luby sequence of nodes, with the cells and the states in a random order (--restarts=on|off)
+    unsigned int seed;              // Seed of the random orders of the restarts (--seed=N), each worker adds its id so that the workers diversify
+    bool learning;                  // Conflict analysis of the backtracking search, recording nogoods and backjumping, chronological backtracking when off (--learning=on|off)
+} SolverConfig;
+
+// Definition of a decision taken by the backtracking search
+typedef struct Decision {
+    int cell;                       // Index of the decided cell in the board
+    int cursor;                     // Position of the cell in the unknown index matrix, the search resumes after it
+    int trail_mark;                 // Size of the trail before the decision was applied
+    CellState first_state;          // State tried first on the cell, the alternative is the other one
+    bool alternative_tried;         // Flag to indicate if the alternative state has already been tried
+    ScatterType group_line;         // Line of the duplicate group the cell belongs to, a black cell moves the search to the next member of the group
+} Decision;
+
+// Union-find of the black cells connected through their diagonals, the last node stands for the border of the board
+typedef struct BlackChains {
+    int *parent;                    // Parent of each node in the union-find
+    int *size;                      // Number of nodes in the tree rooted in each node
+    int *merged_roots;              // Stack of the roots attached below another root, used to undo the unions
+    int merged_count;               // Number of roots in the stack
+    int *cell_unions;               // Number of unions done when each black cell was added
+} BlackChains;
+
+// Legal black masks of the rows of the board, bit j of a mask is set when the cell in column j is black
+typedef struct RowPatterns {
+    uint32_t *masks;                // Masks of all the rows, the masks of a row start at its offset
+    int *offsets;                   // Index in masks of the first mask of each row
+    int *counts;                    // Number of masks of each row still consistent with the other rows
+    uint32_t *same_values;          // Columns in which two rows have the same value, indexed as [row1 * rows_count + row2]
+} RowPatterns;
+
+// State of a search over the row patterns, each worker has its own
+typedef struct RowSearch {
+    uint32_t *masks;                // Copy of the masks of the rows, reordered so that the domain of each row is a prefix of its masks
+    int *domain_counts;             // Number of masks in the domain of each row at each depth, indexed as [depth * rows_count + row]
+    int *choices;                   // Index of the mask chosen for each row, in its domain
+    uint32_t *white_rows;           // White cells of the chosen rows
+    uint32_t *reached_rows;         // White cells reached by the connectivity check
+    int depth;                      // Number of rows with a chosen mask
+    int first_row_stride;           // Step between the masks of the first row tried by the search, used to split them among the workers
+    long long nodes;                // Number of row masks tried since the counter was last collected
+} RowSearch;
+
+// Definition of the results of a step of the row patterns search
+typedef enum RowSearchResult {
+    ROW_SEARCH_FOUND = 0,           // All the rows have a mask and the white cells are connected
+    ROW_SEARCH_EXHAUSTED = 1,       // All the masks of the first row assigned to the search have been tried
+    ROW_SEARCH_PAUSED = 2           // The maximum number of masks of the step has been tried
+} RowSearchResult;
+
+// State of a CDCL solver over the cells of the board, with a variable per cell that is true when the cell is black. Each worker has its own
+typedef struct CdclSolver {
+    int variables_count;            // Number of variables, one per cell
+    int *clause_literals;           // Literals of all the clauses, the literals of a clause start at its offset
+    int *clause_offsets;            // Index in clause_literals of the first literal of each clause, with an extra entry for the end of the last one
+    int *clause_lbds;               // Number of distinct decision levels of each clause when it was added, used to keep the best learned clauses
+    int clauses_count;              // Number of clauses, the learned ones follow the ones of the board
+    int board_clauses_count;        // Number of clauses encoding the first two rules, never deleted
+    int literals_capacity;          // Allocated size of clause_literals
+    int clauses_capacity;           // Allocated number of clauses
+    int max_learned;                // Number of learned clauses that triggers the reduction of the clause database
+    int **watches;                  // Clauses watching each literal, a clause watches its first two literals
+    int *watches_count;             // Number of clauses watching each literal
+    int *watches_capacity;          // Allocated size of the watch list of each literal
+    CellState *values;              // State of each cell, UNKNOWN if not assigned
+    CellState *saved_phases;        // Last state of each cell, tried first when the cell is decided again
+    int *levels;                    // Decision level at which each cell was assigned
+    int *reasons;                   // Clause that forced each cell, -1 for the decisions and the cells known from the pruning
+    int *trail;                     // Literals made true, in assignment order
+    int trail_size;                 // Number of literals in the trail
+    int propagation_head;           // Index of the next trail literal to propagate
+    int *level_starts;              // Trail size before the decision of each level, indexed by the level the decision was taken at
+    int decision_level;             // Number of decisions in the trail
+    double *activities;             // VSIDS activity of each cell, the unassigned cell with the highest one is decided first
+    double activity_increment;      // Amount added to the activity of the cells involved in a conflict, it grows so that the older conflicts decay
+    bool *seen;                     // Scratch flags of the conflict analysis
+    int *learned;                   // Scratch buffer of the learned clause and of a connectivity cut
+    int *cut_literals;              // Scratch buffer of the other connectivity cut
+    int *flood_queue;               // Scratch queue of the connectivity check
+    int *flood_marks;               // Scratch marks of the connectivity check, the cells with the current mark have been reached
+    int flood_mark;                 // Current mark of the connectivity check
+    int restarts;                   // Number of restarts done, the position in the Luby sequence
+    long long restart_conflicts;    // Number of conflicts since the last restart
+    unsigned int random_state;      // State of the generator of the initial activities, seeded differently by each worker
+    long long nodes;                // Number of decisions since the counter was last collected
+} CdclSolver;
+
+// Definition of the results of a step of the CDCL search
+typedef enum CdclResult {
+    CDCL_SATISFIABLE = 0,           // All the cells are assigned and the white cells are connected
+    CDCL_UNSATISFIABLE = 1,         // A conflict was derived without decisions, the board has no solution
+    CDCL_PAUSED = 2                 // The maximum number of conflicts of the step has been reached
+} CdclResult;
+
+// Sweep of the frontier engine over the cells in row-major order. After each cell, a layer holds the states of the frontier: the last cols_count cells,
+// one per column, with the connected components of the white ones, and the later cells that cannot be white because of a white cell with the same value.
+// The partial solutions reaching equal states are merged, and each state keeps the candidate it was first reached from, to rebuild a solution
+typedef struct FrontierSweep {
+    int cells_count;                // Number of cells of the board, one layer per cell
+    int label_words;                // Words of the labels of a state, one byte per column, 0 for a black cell and the component of a white one
+    int state_words;                // Words of a state, the labels followed by the bit set of the later cells that cannot be white
+    uint64_t *same_values;          // Later cells with the same value in the row or the column of each cell, the words of the bit set per cell
+    uint64_t *states;               // States of the current layer
+    long long *counts;              // Number of partial solutions reaching each state of the current layer, saturated at LLONG_MAX
+    int states_count;               // Number of states of the current layer
+    uint64_t *candidates;           // States reached from the current layer with the next cell white, then black, two per state
+    bool *valid;                    // Flag of the candidates that respect the rules
+    int candidates_capacity;        // Allocated number of candidates
+    uint64_t *next_states;          // States of the next layer, the candidates merged when equal
+    long long *next_counts;         // Number of partial solutions reaching each state of the next layer
+    long long *next_origins;        // Origin of each state of the next layer, see FRONTIER_ORIGIN
+    int next_count;                 // Number of states of the next layer
+    int states_capacity;            // Allocated number of states of the current and of the next layer
+    int *table;                     // Open addressing hash table of the next layer, with the index + 1 of each state and 0 for the empty slots
+    int table_size;                 // Number of slots of the table, a power of two at least twice the capacity
+    long long **origins;            // Origins of the states of each layer swept
+    int layers_count;               // Number of layers swept
+    long long stored_states;        // Number of states kept in all the layers
+    long long solutions_count;      // Number of solutions once all the layers are swept, saturated at LLONG_MAX
+    bool overflow;                  // Flag set when a layer or the whole sweep exceeds its maximum number of states
+} FrontierSweep;
+
+// Bounded store of the nogoods learned by the backtracking search, combinations of decided cell states that lead to a conflict
+typedef struct NogoodStore {
+    int *literals;                  // Cells of each nogood with their states, as 2 * cell + state, NOGOOD_MAX_LITERALS per nogood
+    int *lengths;                   // Number of cells of each nogood
+    long long *last_used;           // Time at which each nogood was recorded or last detected a conflict, the least recently used one is evicted first
+    bool *local;                    // Flag of the nogoods that depend on the cells assumed by the block, the solution space or the cube, and only hold in it
+    bool *exported;                 // Flag of the nogoods already sent to the other workers, or received from them
+    int count;                      // Number of nogoods in the store
+    long long clock;                // Number of conflicts analyzed on the block, the time of the store
+} NogoodStore;
+
 // Board Control Block
 typedef struct BCB {
     CellState *solution;            // This matrix contains the solution for the block
     bool *solution_space_unknowns;  // This matrix defines for each unknown if it has been marked as a cell state in the solution space definition
+    int *row_white_counts;          // This matrix counts the white cells of each value in each row, indexed as [row * (cols_count + 1) + value]
+    int *col_white_counts;          // This matrix counts the white cells of each value in each column, indexed as [col * (rows_count + 1) + value]
+    uint64_t *white_rows;           // Bit rows of the white cells, WORDS_PER_ROW(cols_count) words per row
+    uint64_t *black_rows;           // Bit rows of the black cells, a cell is known when its bit is set in either of the two
+    int *trail;                     // Cells assigned by the search in assignment order, reset to unknown when backtracking
+    int trail_size;                 // Number of cells in the trail
+    Decision *decisions;            // Stack of the decisions taken by the search
+    int decisions_count;            // Number of decisions in the stack
+    BlackChains chains;             // Diagonal chains of the black cells, a black cell closing a chain would split the white cells
+    long long nodes;                // Number of cell assignments tried on the block since the counter was last collected
+    int *cell_levels;               // Number of decisions in the stack when each trail cell was assigned, 0 for the cells assigned before the first decision
+    uint64_t *decision_reasons;     // Conflict that forced the alternative state of each decision, CONFLICT_WORDS(cells_count) words per decision
+    uint64_t *conflict_levels;      // Levels of the decisions and assumed cells responsible for the last conflict, as bit sets
+    int conflict_cell;              // Cell that could not take its state in the last conflict
+    CellState conflict_state;       // State the cell of the last conflict was forced to
+    int conflict_source;            // Trail cell whose propagation forced the cell of the last conflict, -1 when it was a decision
+    bool learning;                  // Flag to enable the conflict analysis, off when the leaves of the block are shared with other processes
+    long long conflict_budget;      // Number of conflicts the search may still meet before pausing, 0 for no limit
+    bool paused;                    // Flag of a search paused by the conflict budget, the next leaf resumes it
+    NogoodStore nogoods;            // Nogoods learned on the block
+    int *cell_order;                // Unknown cells of the board in the random order of the restarts, NULL when the block does not restart
+    int order_length;               // Number of cells in the random order
+    CellState *phases;              // State tried first on each cell with the restarts, drawn again at each restart
+    unsigned int random_state;      // State of the generator of the random orders
+    int restarts;                   // Number of restarts done, the position in the Luby sequence
+    long long restart_nodes;        // Number of nodes since the last restart
 } BCB;
 
 // Definition of the circular queue structure 
@@ -0,0 +1,15 @@
+#ifndef PATTERNS_H
+#define PATTERNS_H
+
+#include "common.h"
+
+// Bit of the pair of cells (i, j) of a window, with i < j, in the pair masks of the pattern rules
+#define PATTERN_PAIR(i, j) (1u << ((i) * PATTERN_MAX_CELLS + (j)))
+
+int compile_patterns(PatternRule *table, int table_count, PatternRule *rules);
+int line_patterns(PatternRule *rules);
+int corner_patterns(PatternRule *rules);
+int apply_patterns(PatternRule *rules, int rules_count, int *values, int *cells, int *solution);
+int mark_cell(int *solution, int cell_index, CellState cell_state);
+
+#endif
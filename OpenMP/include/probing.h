@@ -0,0 +1,16 @@
+#ifndef PROBING_H
+#define PROBING_H
+
+#include "common.h"
+
+// Flags of the cells forced by the probes, a cell with both flags makes the board unsolvable
+#define PROBE_FORCED_WHITE 1
+#define PROBE_FORCED_BLACK 2
+
+void init_probe_block(Board board, BCB *block);
+bool probe_cell(Board board, BCB *block, int cell_index, int *probe_trail, int *forced_flags);
+bool try_probe_state(Board board, BCB *block, int cell_index, CellState cell_state);
+bool apply_forced_flags(Board board, BCB *block, int *forced_flags, int *fixed_count);
+bool propagate_known_cells(Board board, CellState *solution, int *changed_count);
+
+#endif
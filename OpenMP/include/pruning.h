@@ -3,13 +3,11 @@
 
 #include "common.h"
 
-Board uniqueness_rule(Board board);
-Board set_white(Board board);
-Board set_black(Board board);
-Board sandwich_rules(Board board);
-Board pair_isolation(Board board);
-void compute_corner(Board board, int x, int y, CornerType corner_type, int **local_corner_solution);
-Board corner_cases(Board board);
-Board flanked_isolation(Board board);
+int compute_corner(Board board, int x, int y, CornerType corner_type, int *solution);
+int sweep_line(Board board, int *solution, PatternRule *rules, int rules_count, int line, ScatterType line_type);
+Board fused_basic_rules(Board board);
+Board two_sat_rule(Board board);
+Board fixed_point_propagation(Board board);
+Board failed_literal_probing(Board board);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef TWO_SAT_H
+#define TWO_SAT_H
+
+#include "common.h"
+
+// Literals of the implication graph, each cell has a literal for its black state and one for its white state, one the negation of the other
+#define BLACK_LITERAL(cell_index) (2 * (cell_index))
+#define WHITE_LITERAL(cell_index) (2 * (cell_index) + 1)
+
+bool solve_two_sat(Board board, CellState *forced);
+int collect_implications(Board board, int *from, int *to);
+void add_implication(int *from, int *to, int *count, int source, int destination);
+void build_implication_graph(Board board, int **edge_offsets, int **edges);
+int compute_components(int literals_count, int *edge_offsets, int *edges, int *component);
+
+#endif
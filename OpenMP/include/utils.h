@@ -7,5 +7,6 @@ void write_solution(Board board);
 void print_vector(int *vector, int size);
 void print_block(Board board, char *title, BCB* block);
 void free_memory(int *pointers[]);
+SolverConfig read_config(int argc, char **argv);
 
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <string.h>
 
 #include "../include/board.h"
+#include "../include/occurrences.h"
 
 void read_board(Board* board, char *filename) {
 
@@ -66,6 +67,12 @@ void read_board(Board* board, char *filename) {
         do {  
             board->grid[temp_row * cols + temp_col] = atoi(token);
             board->solution[temp_row * cols + temp_col] = UNKNOWN;
+
+            // The white counters of the blocks are indexed by value, so the values must be in the range [1, cols]
+            if (board->grid[temp_row * cols + temp_col] < 1 || board->grid[temp_row * cols + temp_col] > cols) {
+                printf("The board values must be between 1 and %d.\n", cols);
+                exit(-1);
+            }
             temp_col++;
         } while ((token = strtok(NULL, " ")));
 
@@ -73,6 +80,8 @@ void read_board(Board* board, char *filename) {
     }
 
     fclose(fp);
+
+    board->occurrences = build_value_occurrences(*board);
 } 
 
 void print_board(char *title, Board board, BoardType type) {
@@ -110,30 +119,9 @@ void print_board(char *title, Board board, BoardType type) {
     printf("%s", buffer);
 }
 
-bool is_board_solution_equal(Board first_board, Board second_board) {
-    /*
-        Helper function to check if two boards are equal.
-    */
-
-    /*
-        Parameters:
-            - first_board: the first board to be compared
-            - second_board: the second board to be compared
-    */
-
-    if (first_board.rows_count != second_board.rows_count || first_board.cols_count != second_board.cols_count) return false;
-
-    int i, j;
-    for (i = 0; i < first_board.rows_count; i++)
-        for (j = 0; j < first_board.cols_count; j++)
-            if (first_board.solution[i * first_board.cols_count + j] != second_board.solution[i * first_board.cols_count + j]) return false;
-
-    return true;
-}
-
 Board transpose(Board board) {
     /*
-        Helper function to transpose a board.
+        Helper function to transpose a board. The transposed board only lays out the columns as rows, it has no occurrences.
     */
 
     /*
@@ -141,7 +129,7 @@ Board transpose(Board board) {
             - board: the board to be transposed
     */
 
-    Board Tboard = { (int *) malloc(board.rows_count * board.cols_count * sizeof(int)), board.cols_count, board.rows_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)) };
+    Board Tboard = { (int *) malloc(board.rows_count * board.cols_count * sizeof(int)), board.cols_count, board.rows_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)), NULL };
 
     int i, j;
     for (i = 0; i < board.rows_count; i++) {
@@ -154,42 +142,49 @@ Board transpose(Board board) {
     return Tboard;
 }
 
-Board combine_boards(Board first_board, Board second_board, bool forced, char *technique) {
-    
-    int rows = -1, cols = -1;
-
-    rows = first_board.rows_count;
-    cols = first_board.cols_count;
+int merge_solutions(int *solution, int *partial, int cells_count, bool forced) {
 
     /*
-        Initialize the solution board with the values of the original board.
+        Helper function to merge a partial solution into the working solution, in place.
     */
 
-    Board merged = { (int *) malloc(rows * cols * sizeof(int)), rows, cols, (int *) malloc(rows * cols * sizeof(int)) };
+    /*
+        Parameters:
+            - solution: the working solution, overwritten with the merged cells
+            - partial: the partial solution to be merged
+            - cells_count: the number of cells of the board
+            - forced: if the technique is forced, the values must be the same
+
+        Returns the number of cells where one solution is WHITE and the other one is BLACK.
+    */
 
-    merged.grid = first_board.grid;
+    int i, conflicts = 0;
 
     /*
-        Combine the solutions by performing a pairwise comparison:
-        1) If the values are the same, keep the value
-        2) If only one value is unknown, keep the known value
-        3) If the values are different, leave the cell as unknown
-    */
+        Merge the solutions by performing a branchless pairwise comparison:
+            1) If the values are the same, keep the value
+            2) If only one value is unknown, keep the known value (UNKNOWN is the smallest state, so the maximum)
+            3) If the values are WHITE and BLACK, their sum is 1: count the conflict and leave the cell as unknown
 
-    memset(merged.solution, UNKNOWN, rows * cols * sizeof(int));
+        Forced techniques must require the values to be the same.
+    */
 
-    int i, j;
-    
-    for (i = 0; i < rows; i++) {
-        for (j = 0; j < cols; j++) {
-            if (first_board.solution[i * cols + j] == second_board.solution[i * cols + j]) 
-                merged.solution[i * cols + j] = first_board.solution[i * cols + j];
-            else if (first_board.solution[i * cols + j] == UNKNOWN && second_board.solution[i * cols + j] != UNKNOWN) 
-                merged.solution[i * cols + j] = second_board.solution[i * cols + j];
-            else if (first_board.solution[i * cols + j] != UNKNOWN && second_board.solution[i * cols + j] == UNKNOWN) 
-                merged.solution[i * cols + j] = first_board.solution[i * cols + j];
-        }   
+    if (forced) {
+        #pragma omp simd reduction(+:conflicts)
+        for (i = 0; i < cells_count; i++) {
+            int first = solution[i], second = partial[i];
+            conflicts += (first + second == 1);
+            solution[i] = first == second ? first : UNKNOWN;
+        }
+    } else {
+        #pragma omp simd reduction(+:conflicts)
+        for (i = 0; i < cells_count; i++) {
+            int first = solution[i], second = partial[i];
+            int conflict = (first + second == 1);
+            conflicts += conflict;
+            solution[i] = (first > second ? first : second) - 2 * conflict;
+        }
     }
 
-    return merged;
+    return conflicts;
 }
@@ -13,6 +13,9 @@
 #include "../include/queue.h"
 #include "../include/validation.h"
 #include "../include/backtracking.h"
+#include "../include/row_patterns.h"
+#include "../include/cdcl.h"
+#include "../include/frontier.h"
 
 /* ------------------ GLOBAL VARIABLES ------------------ */
 Board board;
@@ -22,6 +25,14 @@ Queue *leaf_queues;
 // ----- Backtracking variables -----
 bool terminated = false;
 int *unknown_index, *unknown_index_length;
+long long nodes_explored = 0;
+SolverConfig config;
+
+// ----- Row patterns variables -----
+RowPatterns row_patterns;
+
+// ----- CDCL variables -----
+bool refuted = false;
 
 void task_build_solution_space(int solution_space_id){
     
@@ -30,19 +41,23 @@ void task_build_solution_space(int solution_space_id){
         fflush(stdout);
     }
     
-    // Initialize the starting block
-    BCB block = {
-        .solution = malloc(board.rows_count * board.cols_count * sizeof(CellState)),
-        .solution_space_unknowns = malloc(board.rows_count * board.cols_count * sizeof(bool))
-    };
-    
-    // Fill the block 
-    init_solution_space(board, &block, solution_space_id, &unknown_index);
+    // Initialize and fill the starting block
+    BCB block;
+    bool space_found = init_solution_space(board, &block, solution_space_id, &unknown_index);
 
     int solutions_to_skip = 0, threads_in_solution_space = 1;
-    // Find the first leaf
-    bool leaf_found = build_leaf(board, &block, 0, 0, &unknown_index, &unknown_index_length, &threads_in_solution_space, &solutions_to_skip);
+
+    // With the restarts, each solution space draws its random orders from its own seed
+    SolverConfig space_config = config;
+    space_config.seed += solution_space_id;
+
+    // Find the first leaf, an empty solution space has none
+    bool leaf_found = space_found && build_leaf(board, &block, space_config, &unknown_index, &unknown_index_length, &threads_in_solution_space, &solutions_to_skip);
     
+    #pragma omp atomic
+    nodes_explored += block.nodes;
+    block.nodes = 0;
+
     if (leaf_found) {
         // If a leaf is found, check if it is a solution
         if (check_hitori_conditions(board, &block)) {
@@ -105,6 +120,12 @@ void task_find_solution(int thread_id, int threads_in_solution_space, int soluti
     */
 
     bool leaf_found = false;
+    long long local_nodes = 0;
+
+    // The blocks keep the random orders drawn when their leaf was built, the seed of the thread only serves the blocks without one
+    SolverConfig thread_config = config;
+    thread_config.seed += SOLUTION_SPACES + thread_id;
+
     while(!terminated) {
         if (isEmpty(&local_queue) || terminated) {
             if (DEBUG) {
@@ -116,7 +137,9 @@ void task_find_solution(int thread_id, int threads_in_solution_space, int soluti
 
         // Dequeue the block from the local queue
         BCB current = dequeue(&local_queue);
-        leaf_found = next_leaf(board, &current, &unknown_index, &unknown_index_length, &threads_in_solution_space, &solutions_to_skip);
+        leaf_found = next_leaf(board, &current, thread_config, &unknown_index, &unknown_index_length, &threads_in_solution_space, &solutions_to_skip);
+        local_nodes += current.nodes;
+        current.nodes = 0;
         
         // If a leaf is found, check if it is a solution
         if (leaf_found) {
@@ -140,6 +163,9 @@ void task_find_solution(int thread_id, int threads_in_solution_space, int soluti
             fflush(stdout);
         }
     }
+
+    #pragma omp atomic
+    nodes_explored += local_nodes;
 }
 
 bool hitori_openmp_solution() {
@@ -177,20 +203,26 @@ bool hitori_openmp_solution() {
         // Random pick one thread as the master that will spawn the tasks
         #pragma omp single
         {
+            /*
+                Only the solution spaces that produced a leaf are in the queue, the others have been fully explored while building it.
+                If the solution has already been found, there is nothing to distribute.
+            */
+
             int count = 0;
-            for (i = 0; i < max_threads; i++) {
+            int solution_spaces = terminated ? 0 : getQueueSize(&solution_queue);
+            for (i = 0; i < max_threads && solution_spaces > 0; i++) {
 
                 /*
                     Determine the number of blocks per thread and the number of threads per block
                 */
 
-                int blocks_per_thread = SOLUTION_SPACES / max_threads;
-                if (SOLUTION_SPACES % max_threads > i)
+                int blocks_per_thread = solution_spaces / max_threads;
+                if (solution_spaces % max_threads > i)
                     blocks_per_thread++;
                 blocks_per_thread = blocks_per_thread < 1 ? 1 : blocks_per_thread;
 
-                int threads_per_block = max_threads / SOLUTION_SPACES;
-                if (max_threads % SOLUTION_SPACES > i)
+                int threads_per_block = max_threads / solution_spaces;
+                if (max_threads % solution_spaces > i % solution_spaces)
                     threads_per_block++;
                 threads_per_block = threads_per_block < 1 ? 1 : threads_per_block;
 
@@ -204,19 +236,14 @@ bool hitori_openmp_solution() {
                 for (j = 0; j < blocks_per_thread; j++) {
                     BCB block = dequeue(&solution_queue);
                     
-                    BCB new_block = {
-                        .solution = malloc(board.rows_count * board.cols_count * sizeof(CellState)),
-                        .solution_space_unknowns = malloc(board.rows_count * board.cols_count * sizeof(bool))
-                    };
-
-                    memcpy(new_block.solution, block.solution, board.rows_count * board.cols_count * sizeof(CellState));
-                    memcpy(new_block.solution_space_unknowns, block.solution_space_unknowns, board.rows_count * board.cols_count * sizeof(bool));
+                    BCB new_block;
+                    copy_block(board, &new_block, &block);
 
                     enqueue(&solution_queue, &block);
                     enqueue(&leaf_queues[i], &new_block);
                 }
                 
-                int solutions_to_skip = count / SOLUTION_SPACES;
+                int solutions_to_skip = count / solution_spaces;
                 
                 if (DEBUG) {
                     printf("Starting task with %d %d %d\n", i, threads_per_block, solutions_to_skip);
@@ -237,18 +264,169 @@ bool hitori_openmp_solution() {
     return terminated;
 }
 
+void task_search_row_patterns(int thread_id, int threads_count) {
+
+    /*
+        Each thread searches the masks of the first row congruent to its id, pausing every ROW_SEARCH_STEPS masks to check the termination
+    */
+
+    RowSearch search;
+    init_row_search(board, &row_patterns, &search, thread_id, threads_count);
+
+    RowSearchResult result = ROW_SEARCH_PAUSED;
+    while (!terminated && result == ROW_SEARCH_PAUSED)
+        result = search_row_patterns(board, &row_patterns, &search, ROW_SEARCH_STEPS);
+
+    if (result == ROW_SEARCH_FOUND) {
+        // Only the first solution found is copied to the global solution
+        #pragma omp critical
+        {
+            if (!terminated) {
+                terminated = true;
+                row_search_to_solution(board, &search, board.solution);
+            }
+        }
+        if (DEBUG) {
+            printf("[%d] Solution found\n", thread_id);
+            fflush(stdout);
+        }
+    }
+
+    #pragma omp atomic
+    nodes_explored += search.nodes;
+
+    free_row_search(&search);
+}
+
+bool hitori_openmp_row_patterns() {
+
+    int max_threads = omp_get_max_threads();
+
+    #pragma omp parallel
+    {
+        int i;
+        // Random pick one thread as the master that will spawn the tasks
+        #pragma omp single
+        {
+            for (i = 0; i < max_threads; i++) {
+                #pragma omp task firstprivate(i)
+                task_search_row_patterns(i, max_threads);
+            }
+        }
+    }
+
+    // Implicitly wait for all the tasks to finish
+
+    return terminated;
+}
+
+void task_search_cdcl(int thread_id) {
+
+    /*
+        Each thread runs its own solver on the whole board, seeded with its id so that the threads decide the cells in different orders.
+        The solver pauses every CDCL_SEARCH_CONFLICTS conflicts to check the termination.
+    */
+
+    CdclSolver solver;
+    init_cdcl_solver(board, &solver, thread_id + 1);
+
+    CdclResult result = CDCL_PAUSED;
+    while (!terminated && !refuted && result == CDCL_PAUSED)
+        result = search_cdcl(board, &solver, CDCL_SEARCH_CONFLICTS);
+
+    if (result == CDCL_SATISFIABLE) {
+        // Only the first solution found is copied to the global solution
+        #pragma omp critical
+        {
+            if (!terminated) {
+                terminated = true;
+                cdcl_to_solution(board, &solver, board.solution);
+            }
+        }
+        if (DEBUG) {
+            printf("[%d] Solution found\n", thread_id);
+            fflush(stdout);
+        }
+    } else if (result == CDCL_UNSATISFIABLE) {
+        // The proof holds for the whole board, the other threads can stop
+        #pragma omp atomic write
+        refuted = true;
+    }
+
+    #pragma omp atomic
+    nodes_explored += solver.nodes;
+
+    free_cdcl_solver(&solver);
+}
+
+bool hitori_openmp_cdcl() {
+
+    int max_threads = omp_get_max_threads();
+
+    #pragma omp parallel
+    {
+        int i;
+        // Random pick one thread as the master that will spawn the tasks
+        #pragma omp single
+        {
+            for (i = 0; i < max_threads; i++) {
+                #pragma omp task firstprivate(i)
+                task_search_cdcl(i);
+            }
+        }
+    }
+
+    // Implicitly wait for all the tasks to finish
+
+    return terminated;
+}
+
+bool hitori_openmp_frontier(bool *solution_found) {
+
+    /*
+        Sweep the board cell by cell with the frontier engine. The threads expand the states of each layer in parallel, then the candidates
+        are merged in order, so that the layers do not depend on the number of threads. All the solutions are counted and the first one is kept.
+        It returns false if the sweep exceeds its maximum number of states, in which case the board has to be searched by another engine.
+    */
+
+    FrontierSweep sweep;
+    init_frontier_sweep(board, &sweep);
+
+    int i, cell_index;
+    for (cell_index = 0; cell_index < sweep.cells_count && sweep.states_count > 0 && !sweep.overflow; cell_index++) {
+        prepare_frontier_layer(&sweep);
+
+        #pragma omp parallel for schedule(static)
+        for (i = 0; i < sweep.states_count; i++)
+            expand_frontier_states(board, &sweep, cell_index, i, i + 1);
+
+        merge_frontier_candidates(&sweep, 0);
+        finish_frontier_layer(&sweep);
+    }
+
+    bool available = !sweep.overflow;
+    *solution_found = available && sweep.layers_count == sweep.cells_count && sweep.states_count > 0;
+    if (*solution_found) frontier_to_solution(&sweep, 0, board.solution);
+    if (available) printf("Solutions counted: %lld\n", sweep.solutions_count);
+
+    nodes_explored += sweep.stored_states;
+    free_frontier_sweep(&sweep);
+    return available;
+}
+
 int main(int argc, char** argv) {
 
     /*
         Read the board from the input file
     */
 
-    if (argc != 2) {
+    if (argc < 2) {
         printf("[ERROR] input file not provided!\n");
         exit(-1);
     }
 
     read_board(&board, argv[1]);
+    config = read_config(argc, argv);
     
     /*
         Print the initial board
@@ -264,11 +442,8 @@ int main(int argc, char** argv) {
     */
 
     Board (*techniques[])(Board) = {
-        uniqueness_rule,
-        sandwich_rules,
-        pair_isolation,
-        flanked_isolation,
-        corner_cases
+        fused_basic_rules,
+        two_sat_rule
     };
     int num_techniques = sizeof(techniques) / sizeof(techniques[0]);
 
@@ -291,26 +466,38 @@ int main(int argc, char** argv) {
 
     // Implicitly wait for all the tasks to finish
 
-    for (i = 0; i < num_techniques; i++)
-        board = combine_boards(board, partials[i], false, "Partial");
-    
     /*
-        Repeat the whiting and blacking pruning techniques until the solution doesn't change
+        Merge the partial solutions in place into the board solution, a cell marked white by a technique and black by another one
+        means that the board has no solution
     */
 
-    while (true) {
+    int cells_count = board.rows_count * board.cols_count;
+    for (i = 0; i < num_techniques; i++) {
+        int conflicts = merge_solutions(board.solution, partials[i].solution, cells_count, false);
+        free(partials[i].solution);
+
+        if (conflicts > 0) {
+            printf("[ERROR] The board has no solution, %d cells of the pruning techniques are both white and black\n", conflicts);
+            exit(-1);
+        }
+    }
+    free(partials);
+    
+    /*
+        Propagate the known cells with the whiting and blacking rules until the solution doesn't change
+    */
 
-        Board white_solution = set_white(board);
-        Board black_solution = set_black(board);
+    Board propagated = fixed_point_propagation(board);
+    free(board.solution);
+    board = propagated;
 
-        Board partial = combine_boards(board, white_solution, false, "Partial");
-        Board new_solution = combine_boards(partial, black_solution, false, "Partial");
+    /*
+        Probe the remaining unknown cells, fixing the ones whose other state leads to a conflict, until nothing changes
+    */
 
-        if(!is_board_solution_equal(board, new_solution)) 
-            board = new_solution;
-        else 
-            break;
-    }
+    Board probed = failed_literal_probing(board);
+    free(board.solution);
+    board = probed;
     double pruning_end_time = omp_get_wtime();
 
     if (DEBUG) {
@@ -332,11 +519,26 @@ int main(int argc, char** argv) {
     compute_unknowns(board, &unknown_index, &unknown_index_length);
     
     /*
-        Apply the recursive backtracking algorithm to find the solution
+        Apply the selected engine to find the solution. The row patterns engine falls back to the backtracking
+        when the board has too many columns or rows with too many legal masks, the frontier engine when it has too many columns or states.
     */
 
     double recursive_start_time = omp_get_wtime();
-    bool solution_found = hitori_openmp_solution();
+    bool solution_found;
+    if (config.engine == CDCL) {
+        solution_found = hitori_openmp_cdcl();
+    } else if (config.engine == ROW_PATTERNS && build_row_patterns(board, &row_patterns)) {
+        solution_found = hitori_openmp_row_patterns();
+        free_row_patterns(&row_patterns);
+    } else if (config.engine == FRONTIER && board.cols_count <= FRONTIER_MAX_COLS && hitori_openmp_frontier(&solution_found)) {
+        // The sweep found the solution, or proved that there is none
+    } else {
+        if (config.engine == ROW_PATTERNS)
+            printf("Row patterns not available for this board, using the backtracking\n");
+        if (config.engine == FRONTIER)
+            printf("Frontier engine not available for this board, using the backtracking\n");
+        solution_found = hitori_openmp_solution();
+    }
     double recursive_end_time = omp_get_wtime();
 
     /*
@@ -349,6 +551,8 @@ int main(int argc, char** argv) {
 
     printf("Total execution time: %f\n", recursive_end_time - pruning_start_time);
 
+    printf("Nodes explored: %lld (%.0f nodes/sec)\n", nodes_explored, nodes_explored / (recursive_end_time - recursive_start_time));
+
     fflush(stdout);
 
     /*
@@ -0,0 +1,200 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/probing.h"
+#include "../include/backtracking.h"
+#include "../include/validation.h"
+#include "../include/articulation.h"
+
+/*
+    Failed-literal probing: each unknown cell is tentatively set to white and to black, and the assignment is propagated
+    with the same rules of the search. A state that leads to a conflict is impossible, so the cell takes the other one.
+    When both states survive, the cells that take the same state in both propagations are forced as well.
+    The black chain check of is_cell_state_valid rejects the probes that would split the white cells.
+    The probes only read the board, so each worker probes its own cells on its own block and reports the forced cells as flags.
+*/
+
+void init_probe_block(Board board, BCB *block) {
+
+    /*
+        This function is responsible for initializing a block on the current board solution, without any solution space cell.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to initialize
+    */
+
+    block->solution = malloc(board.rows_count * board.cols_count * sizeof(CellState));
+    block->solution_space_unknowns = malloc(board.rows_count * board.cols_count * sizeof(bool));
+
+    memcpy(block->solution, board.solution, board.rows_count * board.cols_count * sizeof(CellState));
+    memset(block->solution_space_unknowns, false, board.rows_count * board.cols_count * sizeof(bool));
+    compute_block_state(board, block);
+    block->nodes = 0;
+}
+
+bool probe_cell(Board board, BCB *block, int cell_index, int *probe_trail, int *forced_flags) {
+
+    /*
+        This function is responsible for probing both states of an unknown cell, setting the flags of the cells it forces.
+        The block is left as it was found. It returns false if neither state can be propagated, meaning the board has no solution.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to probe on, with the cell unknown
+            cell_index: the index of the probed cell in the board
+            probe_trail: the vector filled with the cells assigned by the white probe and their states, as 2 * cell + state
+            forced_flags: the vector of the forced flags of each cell, updated with the cells forced by the probe
+    */
+
+    int i, trail_mark = block->trail_size, probe_trail_size = 0;
+
+    bool white_valid = try_probe_state(board, block, cell_index, WHITE);
+    if (white_valid) {
+        for (i = trail_mark; i < block->trail_size; i++)
+            probe_trail[probe_trail_size++] = 2 * block->trail[i] + block->solution[block->trail[i]];
+        undo_trail(board, block, trail_mark);
+    }
+
+    bool black_valid = try_probe_state(board, block, cell_index, BLACK);
+    if (black_valid) {
+
+        // The cells assigned in the same state by both probes are forced, whatever the state of the probed cell
+        for (i = 1; i < probe_trail_size; i++)
+            if (block->solution[probe_trail[i] / 2] == probe_trail[i] % 2)
+                forced_flags[probe_trail[i] / 2] |= probe_trail[i] % 2 == WHITE ? PROBE_FORCED_WHITE : PROBE_FORCED_BLACK;
+        undo_trail(board, block, trail_mark);
+    }
+
+    if (white_valid && !black_valid)
+        forced_flags[cell_index] |= PROBE_FORCED_WHITE;
+    if (black_valid && !white_valid)
+        forced_flags[cell_index] |= PROBE_FORCED_BLACK;
+
+    return white_valid || black_valid;
+}
+
+bool try_probe_state(Board board, BCB *block, int cell_index, CellState cell_state) {
+
+    /*
+        This function is responsible for assigning a state to the probed cell and propagating it.
+        On a conflict the block is restored and false is returned, otherwise the assignments are left on the trail.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to probe on
+            cell_index: the index of the probed cell in the board
+            cell_state: the state to try (WHITE or BLACK)
+    */
+
+    int trail_mark = block->trail_size;
+
+    if (!is_cell_state_valid(board, block, cell_index / board.cols_count, cell_index % board.cols_count, cell_state))
+        return false;
+
+    assign_cell(board, block, cell_index, cell_state);
+    block->nodes++;
+
+    if (!propagate(board, block, trail_mark)) {
+        undo_trail(board, block, trail_mark);
+        return false;
+    }
+    return true;
+}
+
+bool apply_forced_flags(Board board, BCB *block, int *forced_flags, int *fixed_count) {
+
+    /*
+        This function is responsible for assigning the forced cells to the block and propagating them.
+        The assignments are kept, so the block holds the board solution for the next round of probes.
+        It returns false if a cell is forced in both states or the forced cells are in conflict, meaning the board has no solution.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to update
+            forced_flags: the vector of the forced flags of each cell
+            fixed_count: the number of cells fixed by the forced cells and their propagation
+    */
+
+    int i, trail_mark, initial_trail_size = block->trail_size;
+
+    for (i = 0; i < board.rows_count * board.cols_count; i++) {
+        if (forced_flags[i] == 0) continue;
+        if (forced_flags[i] == (PROBE_FORCED_WHITE | PROBE_FORCED_BLACK)) return false;
+
+        trail_mark = block->trail_size;
+        if (!force_cell(board, block, i / board.cols_count, i % board.cols_count, forced_flags[i] == PROBE_FORCED_WHITE ? WHITE : BLACK))
+            return false;
+        if (!propagate(board, block, trail_mark))
+            return false;
+    }
+
+    *fixed_count = block->trail_size - initial_trail_size;
+    return true;
+}
+
+bool propagate_known_cells(Board board, CellState *solution, int *changed_count) {
+
+    /*
+        This function is responsible for propagating the known cells of the board to a fixed point with a worklist.
+        The known cells are forced on an empty block, whose trail is the queue of the decided cells: propagate only visits
+        the neighbours of a new black cell and the row and column of a new white one, and appends the cells it forces.
+        The connectivity is global, so it is only checked once the queue is drained: the unknown articulation points
+        of the non-black cells are whitened and queued, and the propagation goes on until none is left.
+        It returns false if the known cells lead to a conflict, meaning the board has no solution.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved, with the cells already known
+            solution: the matrix filled with the propagated solution
+            changed_count: the number of cells decided by the propagation
+    */
+
+    int cell_index, trail_mark, known_count = 0, cells_count = board.rows_count * board.cols_count;
+    bool consistent = true;
+
+    Board empty = { board.grid, board.rows_count, board.cols_count, (int *) malloc(cells_count * sizeof(int)), board.occurrences };
+    memset(empty.solution, UNKNOWN, cells_count * sizeof(int));
+
+    BCB block;
+    init_probe_block(empty, &block);
+
+    for (cell_index = 0; cell_index < cells_count && consistent; cell_index++) {
+        if (board.solution[cell_index] == UNKNOWN) continue;
+        known_count++;
+        consistent = force_cell(board, &block, cell_index / board.cols_count, cell_index % board.cols_count, board.solution[cell_index]);
+    }
+    consistent = consistent && propagate(board, &block, 0);
+
+    bool *articulation = (bool *) malloc(cells_count * sizeof(bool));
+    Board partial = { board.grid, board.rows_count, board.cols_count, (int *) block.solution, board.occurrences };
+
+    while (consistent) {
+        trail_mark = block.trail_size;
+        find_articulation_points(partial, articulation);
+
+        for (cell_index = 0; cell_index < cells_count && consistent; cell_index++)
+            if (articulation[cell_index] && block.solution[cell_index] == UNKNOWN)
+                consistent = force_cell(board, &block, cell_index / board.cols_count, cell_index % board.cols_count, WHITE);
+
+        if (block.trail_size == trail_mark) break;
+        consistent = consistent && propagate(board, &block, trail_mark);
+    }
+
+    memcpy(solution, block.solution, cells_count * sizeof(CellState));
+    *changed_count = block.trail_size - known_count;
+
+    free(articulation);
+    free(empty.solution);
+    free_block(&block);
+    return consistent;
+}
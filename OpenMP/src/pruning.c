@@ -1,522 +1,300 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <omp.h>
 
 #include "../include/pruning.h"
 #include "../include/board.h"
+#include "../include/occurrences.h"
+#include "../include/patterns.h"
+#include "../include/black_chains.h"
+#include "../include/two_sat.h"
+#include "../include/probing.h"
+#include "../include/backtracking.h"
 
-Board uniqueness_rule(Board board) {
+int compute_corner(Board board, int x, int y, CornerType corner_type, int *solution) {
 
     /*
         RULE DESCRIPTION:
         
-        If a value is unique in a row or column, mark it as white.
-
-        e.g. 2 3 2 1 1 --> 2 O 2 1 1
-    */
-
-    int i, j, k;
-    bool unique;
-    
-    int *uniqueness_solution = (int *) malloc(board.rows_count * board.cols_count * sizeof(int));
-    memset(uniqueness_solution, UNKNOWN, board.rows_count * board.cols_count * sizeof(int));
-    
-    for (i = 0; i < board.rows_count; i++) {
-        for (j = 0; j < board.cols_count; j++) {
-
-            int current_value = board.grid[i * board.cols_count + j];
-
-            unique = true;
-            for (k = 0; k < board.cols_count; k++) {
-                if (j != k && current_value == board.grid[i * board.cols_count + k]) {
-                    unique = false;
-                    break;
-                }
-            }
-
-            if (unique) {
-                for (k = 0; k < board.rows_count; k++) {
-                    if (i != k && current_value == board.grid[k * board.rows_count + j]) {
-                        unique = false;
-                        break;
-                    }
-                }
+        1) If you have a corner with three similar numbers, mark the angle cell as black
 
-                if (unique)
-                    uniqueness_solution[i * board.cols_count + j] = WHITE; // If the value is unique, mark it as white
-            }
-        }
-    }
+        2) If you have a corner with two similar numbers, you can mark a single as white for all combinations
 
-    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)) };
-    memcpy(solution.solution, uniqueness_solution, board.rows_count * board.cols_count * sizeof(int));
+        3) If you have a corner with two pairs of similar numbers, the diagonal cells must be black
 
-    return solution;
-}
+        4) If you have a black in the corner, the other must be white
 
-Board sandwich_rules(Board board) {
+        It returns the number of conflicting deductions.
+    */
 
     /*
-        RULE DESCRIPTION:
-        
-        1) Sandwich Triple: If you have three on a row, mark the edges as black and the middle as white
+        Get the cells of the corner based on the corner indexes (x, y), the top left and bottom left cells of the 2x2 block, and orient them
+        as seen from the top left corner (see corner_patterns):
+        1) the corner cell
+        2) its neighbour on the row
+        3) its neighbour on the column
+        4) the diagonal cell
+    */
 
-        e.g. 2 2 2 --> X O X
-        
-        2) Sandwich Pair: If you have two similar numbers with one between, you can mark the middle as white
+    int corner_cells[4][4] = {
+        { x, x + 1, y, y + 1 },     // TOP_LEFT
+        { x + 1, x, y + 1, y },     // TOP_RIGHT
+        { y, y + 1, x, x + 1 },     // BOTTOM_LEFT
+        { y + 1, y, x + 1, x }      // BOTTOM_RIGHT
+    };
 
-        e.g. 2 3 2 --> 2 O 2
-    */
+    int *cells = corner_cells[corner_type];
+    int values[PATTERN_MAX_CELLS] = { 0 };
+    int i, conflicts;
 
-    int i, j;
+    PatternRule rules[PATTERN_MAX_RULES];
+    int rules_count = corner_patterns(rules);
 
-    int *sandwich_solution = (int *) malloc(board.rows_count * board.cols_count * sizeof(int));
-    memset(sandwich_solution, UNKNOWN, board.rows_count * board.cols_count * sizeof(int));
+    for (i = 0; i < 4; i++) values[i] = board.grid[cells[i]];
 
-    for (i = 0; i < board.rows_count; i++) {
-        for (j = 0; j < board.cols_count; j++) {
-            if (j < board.cols_count - 2) {
+    /*
+        Triple, Pair and Quad Corner cases, matched by the corner patterns
+    */
 
-                int value1 = board.grid[i * board.cols_count + j];
-                int value2 = board.grid[i * board.cols_count + j + 1];
-                int value3 = board.grid[i * board.cols_count + j + 2];
+    conflicts = apply_patterns(rules, rules_count, values, cells, solution);
 
-                if (value1 == value2 && value2 == value3) {
-                    sandwich_solution[i * board.cols_count + j] = BLACK;
-                    sandwich_solution[i * board.cols_count + j + 1] = WHITE;
-                    sandwich_solution[i * board.cols_count + j + 2] = BLACK;
+    /*
+        Corner Close: If you have a black in the corner, the other must be white
+    */
 
-                    if (j - 1 >= 0) sandwich_solution[i * board.cols_count + j - 1] = WHITE;
-                    if (j + 3 < board.cols_count) sandwich_solution[i * board.cols_count + j + 3] = WHITE;
+    if (board.solution[cells[1]] == BLACK) conflicts += mark_cell(solution, cells[2], WHITE);
+    else if (board.solution[cells[2]] == BLACK) conflicts += mark_cell(solution, cells[1], WHITE);
 
-                } else if (value1 != value2 && value1 == value3) {
-                    sandwich_solution[i * board.cols_count + j + 1] = WHITE;
-                }
-            }
+    return conflicts;
+}
 
-            if (i < board.rows_count - 2) {
+int sweep_line(Board board, int *solution, PatternRule *rules, int rules_count, int line, ScatterType line_type) {
 
-                int value1 = board.grid[i * board.cols_count + j];
-                int value2 = board.grid[(i + 1) * board.cols_count + j];
-                int value3 = board.grid[(i + 2) * board.cols_count + j];
+    /*
+        This function is responsible for applying the uniqueness rule, the line patterns (see line_patterns), the pair isolation and the
+        flanked isolation to a row or a column in a single sweep. A window of five values slides along the line from the cell before the
+        current one, each step shifting in the value three cells ahead (0 outside of the line, the values start from 1), and the singles
+        of the pairs are found through the occurrences. The uniqueness rule checks the row and the column of a cell at once, so it runs
+        on the rows only. It returns the number of conflicting deductions.
+    */
 
-                if (value1 == value2 && value2 == value3) {
-                    sandwich_solution[i * board.cols_count + j] = BLACK;
-                    sandwich_solution[(i + 1) * board.cols_count + j] = WHITE;
-                    sandwich_solution[(i + 2) * board.cols_count + j] = BLACK;
+    /*
+        Parameters:
+            board: the board to be pruned
+            solution: the solution the deductions are written into
+            rules: the compiled line patterns
+            rules_count: the number of line patterns
+            line: the index of the row or column
+            line_type: ROWS or COLS
+    */
 
-                    if (i - 1 >= 0) sandwich_solution[(i - 1) * board.cols_count + j] = WHITE;
-                    if (i + 3 < board.rows_count) sandwich_solution[(i + 3) * board.cols_count + j] = WHITE;
+    int length = line_type == ROWS ? board.cols_count : board.rows_count;
+    int stride = line_type == ROWS ? 1 : board.cols_count;
+    int first_cell = line_type == ROWS ? line * board.cols_count : line;
+    int window[PATTERN_MAX_CELLS], window_cells[PATTERN_MAX_CELLS];
+    int position, cell_index, occurrence, count1, count2, k, conflicts = 0;
+    const int *positions1, *positions2;
+
+    for (k = 1; k < PATTERN_MAX_CELLS; k++) window[k] = k - 2 >= 0 && k - 2 < length ? board.grid[first_cell + (k - 2) * stride] : 0;
+
+    for (position = 0; position < length; position++) {
+        for (k = 0; k < PATTERN_MAX_CELLS - 1; k++) window[k] = window[k + 1];
+        window[PATTERN_MAX_CELLS - 1] = position + 3 < length ? board.grid[first_cell + (position + 3) * stride] : 0;
+        cell_index = first_cell + position * stride;
+
+        // Uniqueness rule: the only occurrence of its value in its row and column is white
+        if (line_type == ROWS && row_occurrences(board, line, window[1], &positions1) == 1 && col_occurrences(board, position, window[1], &positions1) == 1)
+            conflicts += mark_cell(solution, cell_index, WHITE);
+
+        // Line patterns: 2 2 2 --> X O X, 2 3 2 --> 2 O 2
+        for (k = 0; k < PATTERN_MAX_CELLS; k++) window_cells[k] = cell_index + (k - 1) * stride;
+        conflicts += apply_patterns(rules, rules_count, window, window_cells, solution);
+
+        // Pair isolation: 2 2 ... 2 --> 2 2 ... X, when the single is not part of another pair
+        if (window[2] != 0 && window[1] == window[2]) {
+            count1 = line_type == ROWS ? row_occurrences(board, line, window[1], &positions1) : col_occurrences(board, line, window[1], &positions1);
+            for (occurrence = 0; occurrence < count1; occurrence++) {
+                k = positions1[occurrence];
+                if (k == position || k == position + 1) continue;
+                if (k - 1 >= 0 && board.grid[first_cell + (k - 1) * stride] == window[1]) continue;
+                if (k + 1 < length && board.grid[first_cell + (k + 1) * stride] == window[1]) continue;
+
+                conflicts += mark_cell(solution, first_cell + k * stride, BLACK);
+                if (k - 1 >= 0) conflicts += mark_cell(solution, first_cell + (k - 1) * stride, WHITE);
+                if (k + 1 < length) conflicts += mark_cell(solution, first_cell + (k + 1) * stride, WHITE);
+            }
+        }
 
-                } else if (value1 != value2 && value1 == value3) {
-                    sandwich_solution[(i + 1) * board.cols_count + j] = WHITE;
-                }
+        // Flanked isolation: 2 3 3 2 ... 2 ... 3 --> 2 3 3 2 ... X ... X
+        if (window[4] != 0 && window[1] == window[4] && window[2] == window[3] && window[1] != window[2]) {
+            count1 = line_type == ROWS ? row_occurrences(board, line, window[1], &positions1) : col_occurrences(board, line, window[1], &positions1);
+            count2 = line_type == ROWS ? row_occurrences(board, line, window[2], &positions2) : col_occurrences(board, line, window[2], &positions2);
+            for (occurrence = 0; occurrence < count1 + count2; occurrence++) {
+                k = occurrence < count1 ? positions1[occurrence] : positions2[occurrence - count1];
+                if (k >= position && k <= position + 3) continue;
+
+                conflicts += mark_cell(solution, first_cell + k * stride, BLACK);
+                if (k - 1 >= 0) conflicts += mark_cell(solution, first_cell + (k - 1) * stride, WHITE);
+                if (k + 1 < length) conflicts += mark_cell(solution, first_cell + (k + 1) * stride, WHITE);
             }
         }
     }
-
-    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)) };
-    memcpy(solution.solution, sandwich_solution, board.rows_count * board.cols_count * sizeof(int));
-
-    return solution;
+    return conflicts;
 }
 
-Board pair_isolation(Board board) {
+Board fused_basic_rules(Board board) {
 
     /*
         RULE DESCRIPTION:
-        
-        If you have a double and some singles, you can mark all the singles as black
 
-        e.g. 2 2 ... 2 ... 2 --> 2 2 ... X ... X
-    */
-
-    int i, j, k;
+        Apply the uniqueness rule, the sandwich rules, the pair isolation, the flanked isolation and the corner cases in a single pass,
+        writing the deductions straight into one solution: each row and each column is swept once (see sweep_line), then the four corners
+        are merged in. A cell deduced both white and black means that the board has no solution.
 
-    int *pair_isolation_solution = (int *) malloc(board.rows_count * board.cols_count * sizeof(int));
-    memset(pair_isolation_solution, UNKNOWN, board.rows_count * board.cols_count * sizeof(int));
+        e.g. 2 2 2 3 4 3 --> X O X O O 3
+    */
 
-    for (i = 0; i < board.rows_count; i++) {
-        for (j = 0; j < board.cols_count; j++) {
-            if (j < board.cols_count - 1) {
-                int value1 = board.grid[i * board.cols_count + j];
-                int value2 = board.grid[i * board.cols_count + j + 1];
+    int rows = board.rows_count;
+    int cols = board.cols_count;
+    int line, conflicts = 0;
 
-                if (value1 == value2) {
-                    // Found a pair of values next to each other, mark all the other single values as black
-                    for (k = 0; k < board.cols_count; k++) {
-                        int single = board.grid[i * board.cols_count + k];
-                        bool isolated = true;
+    PatternRule line_rules[PATTERN_MAX_RULES];
+    int line_rules_count = line_patterns(line_rules);
 
-                        if (k != j && k != j + 1 && single == value1) {
+    Board solution = { board.grid, rows, cols, (int *) malloc(rows * cols * sizeof(int)), board.occurrences };
+    memset(solution.solution, UNKNOWN, rows * cols * sizeof(int));
 
-                            // Check if the value is isolated
-                            if (k - 1 >= 0 && board.grid[i * board.cols_count + k - 1] == single) isolated = false;
-                            if (k + 1 < board.cols_count && board.grid[i * board.cols_count + k + 1] == single) isolated = false;
+    for (line = 0; line < rows; line++) conflicts += sweep_line(board, solution.solution, line_rules, line_rules_count, line, ROWS);
+    for (line = 0; line < cols; line++) conflicts += sweep_line(board, solution.solution, line_rules, line_rules_count, line, COLS);
 
-                            if (isolated) {
-                                pair_isolation_solution[i * board.cols_count + k] = BLACK;
+    conflicts += compute_corner(board, 0, cols, TOP_LEFT, solution.solution);
+    conflicts += compute_corner(board, cols - 2, 2 * cols - 2, TOP_RIGHT, solution.solution);
+    conflicts += compute_corner(board, (rows - 2) * cols, (rows - 1) * cols, BOTTOM_LEFT, solution.solution);
+    conflicts += compute_corner(board, (rows - 2) * cols + cols - 2, (rows - 1) * cols + cols - 2, BOTTOM_RIGHT, solution.solution);
 
-                                if (k - 1 >= 0) pair_isolation_solution[i * board.cols_count + k - 1] = WHITE;
-                                if (k + 1 < board.cols_count) pair_isolation_solution[i * board.cols_count + k + 1] = WHITE;
-                            }
-                        }
-                    }
-                }
-            }
-            
-            if (i < board.rows_count - 1) {
-                int value1 = board.grid[i * board.rows_count + j];
-                int value2 = board.grid[(i + 1) * board.rows_count + j];
-
-                if (value1 == value2) {
-                    // Found a pair of values next to each other, mark all the other single values as black
-                    for (k = 0; k < board.rows_count; k++) {
-                        int single = board.grid[k * board.rows_count + j];
-                        bool isolated = true;
-
-                        if (k != i && k != i + 1 && single == value1) {
-
-                            // Check if the value is isolated
-                            if (k - 1 >= 0 && board.grid[(k - 1) * board.rows_count + j] == single) isolated = false;
-                            if (k + 1 < board.rows_count && board.grid[(k + 1) * board.rows_count + j] == single) isolated = false;
-
-                            if (isolated) {
-                                pair_isolation_solution[k * board.rows_count + j] = BLACK;
-
-                                if (k - 1 >= 0) pair_isolation_solution[(k - 1) * board.rows_count + j] = WHITE;
-                                if (k + 1 < board.rows_count) pair_isolation_solution[(k + 1) * board.rows_count + j] = WHITE;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+    if (conflicts > 0) {
+        printf("[ERROR] The board has no solution, %d cells of the basic rules are both white and black\n", conflicts);
+        exit(-1);
     }
 
-    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)) };
-    memcpy(solution.solution, pair_isolation_solution, board.rows_count * board.cols_count * sizeof(int));
-
     return solution;
-
 }
 
-Board flanked_isolation(Board board) {
+Board two_sat_rule(Board board) {
 
     /*
         RULE DESCRIPTION:
         
-        If you find two doubles packed, singles must be black
+        The first two rules only bind pairs of cells: two adjacent cells cannot both be black, and two cells with the same value
+        in a row or column cannot both be white. Together with the cells already known they form a 2-SAT problem, solved on its
+        implication graph: a cell is marked when one of its states implies the other one (see two_sat.c).
+        This subsumes the sandwich rules and the set white/black propagation, and proves at once when the board cannot be solved.
 
-        e.g. 2 3 3 2 ... 2 ... 3 --> 2 3 3 2 ... X ... X
+        e.g. 2 3 2 --> 2 O 2 (a black 3 would force both the 2s to white)
     */
 
-    int i, j, k;
-
-    int *flanked_isolation_solution = (int *) malloc(board.rows_count * board.cols_count * sizeof(int));
-    memset(flanked_isolation_solution, UNKNOWN, board.rows_count * board.cols_count * sizeof(int));
-    
-    for (i = 0; i < board.rows_count; i++) {
-        for (j = 0; j < board.cols_count; j++) {
-            if (j < board.cols_count - 3) {
-                int value1 = board.grid[i * board.cols_count + j];
-                int value2 = board.grid[i * board.cols_count + j + 1];
-                int value3 = board.grid[i * board.cols_count + j + 2];
-                int value4 = board.grid[i * board.cols_count + j + 3];
-
-                if (value1 == value4 && value2 == value3 && value1 != value2) {
-                    for (k = 0; k < board.cols_count; k++) {
-                        int single = board.grid[i * board.cols_count + k];
-                        if (k != j && k != j + 1 && k != j + 2 && k != j + 3 && (single == value1 || single == value2)) {
-                            flanked_isolation_solution[i * board.cols_count + k] = BLACK;
-
-                            if (k - 1 >= 0) flanked_isolation_solution[i * board.cols_count + k - 1] = WHITE;
-                            if (k + 1 < board.cols_count) flanked_isolation_solution[i * board.cols_count + k + 1] = WHITE;
-                        }
-                    }
-                }
-            }
-            
-            if (i < board.rows_count - 3) {
-                int value1 = board.grid[i * board.rows_count + j];
-                int value2 = board.grid[(i + 1) * board.rows_count + j];
-                int value3 = board.grid[(i + 2) * board.rows_count + j];
-                int value4 = board.grid[(i + 3) * board.rows_count + j];
-
-                if (value1 == value4 && value2 == value3 && value1 != value2) {
-                    for (k = 0; k < board.rows_count; k++) {
-                        int single = board.grid[k * board.rows_count + j];
-                        if (k != i && k != i + 1 && k != i + 2 && k != i + 3 && (single == value1 || single == value2)) {
-                            flanked_isolation_solution[k * board.rows_count + j] = BLACK;
-
-                            if (k - 1 >= 0) flanked_isolation_solution[(k - 1) * board.rows_count + j] = WHITE;
-                            if (k + 1 < board.rows_count) flanked_isolation_solution[(k + 1) * board.rows_count + j] = WHITE;
-                        }
-                    }
-                }
-            }
-        }
-    }
+    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)), board.occurrences };
 
-    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)) };
-    memcpy(solution.solution, flanked_isolation_solution, board.rows_count * board.cols_count * sizeof(int));
+    if (!solve_two_sat(board, solution.solution)) {
+        printf("[ERROR] The board has no solution, the first two rules cannot be satisfied\n");
+        exit(-1);
+    }
 
     return solution;
 }
 
-void compute_corner(Board board, int x, int y, CornerType corner_type, int **solution) {
-
-    /*
-        Get the values of the corner cells based on the corner indexes (x, y):
-        1) x --> top left 
-        2) x + 1 --> top right
-        3) y --> bottom left
-        4) y + 1 --> bottom right
-    */
-
-    int top_left = board.grid[x];
-    int top_right = board.grid[x + 1];
-    int bottom_left = board.grid[y];
-    int bottom_right = board.grid[y + 1];
-    
-    /*
-        Triple Corner case: if you have a corner with three similar numbers, mark the angle cell as black
-    */
-
-    switch (corner_type) {
-        case TOP_LEFT:
-        case BOTTOM_RIGHT:
-            if (top_left == top_right && top_left == bottom_left) {
-                (*solution)[x] = BLACK;
-                (*solution)[x + 1] = WHITE;
-                (*solution)[y] = WHITE;
-
-            } else if (bottom_right == top_right && bottom_right == bottom_left) {
-                (*solution)[y + 1] = BLACK;
-                (*solution)[y] = WHITE;
-                (*solution)[x + 1] = WHITE;
-            }
-            break;
-        
-        case TOP_RIGHT:
-        case BOTTOM_LEFT:
-            if (top_left == top_right && top_right == bottom_right) {
-                (*solution)[x + 1] = BLACK;
-                (*solution)[x] = WHITE;
-                (*solution)[y + 1] = WHITE;
-
-            } else if (bottom_left == top_left && bottom_left == bottom_right) {
-                (*solution)[y] = BLACK;
-                (*solution)[x] = WHITE;
-                (*solution)[y + 1] = WHITE;
-            }
-            break;
-    }
-
-    
-    /*
-        Pair Corner case: if you have a corner with two similar numbers, you can mark a single as white for all combinations
-    */
-
-    switch (corner_type) {
-        case TOP_LEFT:
-        case BOTTOM_RIGHT:
-            if (top_left == top_right) (*solution)[y] = WHITE;
-            else if (top_left == bottom_left) (*solution)[x + 1] = WHITE;
-            else if (bottom_left == bottom_right) (*solution)[x + 1] = WHITE;
-            else if (top_right == bottom_right) (*solution)[y] = WHITE;
-            break;
-        case TOP_RIGHT:
-        case BOTTOM_LEFT:
-            if (top_left == top_right) (*solution)[y + 1] = WHITE;
-            else if (top_right == bottom_right) (*solution)[x] = WHITE;
-            else if (bottom_left == bottom_right) (*solution)[x] = WHITE;
-            else if (top_left == bottom_left) (*solution)[y + 1] = WHITE;
-            break;
-    }
-
-    /*
-        Quad Corner case: if you have a corner with four similar numbers, the diagonal cells must be black
-    */
-    
-    if ((top_left == top_right && top_left == bottom_left && top_left == bottom_right) ||
-        (top_right == bottom_right && top_left == bottom_left) ||
-        (top_left == top_right && bottom_left == bottom_right)) {
-            
-            switch (corner_type) {        
-                case TOP_LEFT:
-                case BOTTOM_LEFT:
-                    (*solution)[x] = BLACK;
-                    (*solution)[x + 1] = WHITE;
-                    (*solution)[y] = WHITE;
-                    (*solution)[y + 1] = BLACK;
-                    break;
-                case TOP_RIGHT:
-                case BOTTOM_RIGHT:
-                    (*solution)[x] = WHITE;
-                    (*solution)[x + 1] = BLACK;
-                    (*solution)[y] = BLACK;
-                    (*solution)[y + 1] = WHITE;
-                    break;
-            }
-        }
-    
-    /*
-        Corner Close: If you have a black in the corner, the other must be white
-    */
-
-    switch (corner_type) { 
-        case TOP_LEFT:
-        case BOTTOM_RIGHT:
-            if (board.solution[x + 1] == BLACK) (*solution)[y] = WHITE;
-            else if (board.solution[y] == BLACK) (*solution)[x + 1] = WHITE;
-            break;
-        case TOP_RIGHT:
-        case BOTTOM_LEFT:
-            if (board.solution[x] == BLACK) (*solution)[y + 1] = WHITE;
-            else if (board.solution[y + 1] == BLACK) (*solution)[x] = WHITE;
-            break;
-    }
-}
+Board fixed_point_propagation(Board board) {
 
-Board corner_cases(Board board) {  
     /*
         RULE DESCRIPTION:
         
-        1) If you have a corner with three similar numbers, mark the angle cell as black
-
-        2) If you have a corner with two similar numbers, you can mark a single as white for all combinations
-
-        3) If you have a corner with four similar numbers, the diagonal cells must be black
-
-        4) If you have a black in the corner, the other must be white
-    */
-
-    /*
-        Compute the corner cases:
-            1) If 1 process, compute all the corner cases
-            2) If 2 or 3 processes, process 0 computes top corners and process 1 computes bottom corners (if 3, process 2 will be idle)
-            3) If 4 processes or more, each process will compute a corner while the rest will be idle
-    */
+        Propagate the known cells until nothing changes, with a queue of the newly decided cells (see propagate_known_cells):
+        a black cell whitens its neighbours, a white cell blackens the cells with its value in its row and column, and a decided cell
+        is queued in turn. Once the queue is drained, the unknown articulation points of the non-black cells are whitened and queued.
+        Each cell is visited once, when it is decided, instead of rescanning the whole board until it stops changing.
 
-    /*
-        If number of processes is greater than 1, use a different communication strategy:
-            1) Two processes to compute the top and bottom corners (if 2 or 3 processes)
-            2) Four processes to compute each corner (if 4 or more processes)
+        e.g. 2 O ... 2 --> 2 O ... X --> 2 O ... O X O
     */
 
-    int rows = board.rows_count;
-    int cols = board.cols_count;
-    int board_size = rows * cols;
-
-    int top_left_x = 0;
-    int top_left_y = cols;
-
-    int top_right_x = cols - 2;
-    int top_right_y = 2 * cols - 2;
-
-    int bottom_left_x = (rows - 2) * cols;
-    int bottom_left_y = (rows - 1) * cols;
-
-    int bottom_right_x = (rows - 2) * cols + cols - 2;
-    int bottom_right_y = (rows - 1) * cols + cols - 2;
-
-    int *corner_solution = (int *) malloc(board_size * sizeof(int));
-    memset(corner_solution, UNKNOWN, board_size * sizeof(int));
+    int changed_count;
 
-    compute_corner(board, top_left_x, top_left_y, TOP_LEFT, &corner_solution);
-    compute_corner(board, top_right_x, top_right_y, TOP_RIGHT, &corner_solution);
-    compute_corner(board, bottom_left_x, bottom_left_y, BOTTOM_LEFT, &corner_solution);
-    compute_corner(board, bottom_right_x, bottom_right_y, BOTTOM_RIGHT, &corner_solution);
+    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)), board.occurrences };
 
-    /*
-        Initialize the board with the corner solution
-    */
-
-    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(board_size * sizeof(int)) };
-    memcpy(solution.solution, corner_solution, board_size * sizeof(int));
+    if (!propagate_known_cells(board, solution.solution, &changed_count)) {
+        printf("[ERROR] The board has no solution, the propagation of the known cells leads to a conflict\n");
+        exit(-1);
+    }
 
-    free(corner_solution);
+    if (DEBUG) printf("[INFO] The propagation decided %d cells\n", changed_count);
 
     return solution;
 }
 
-Board set_white(Board board) {
-    
+Board failed_literal_probing(Board board) {
+
     /*
         RULE DESCRIPTION:
         
-        When you have whited a cell, you can mark all the other cells with the same number in the row or column as black
-        
-        e.g. Suppose a whited 3. Then 2 O ... 3 --> 2 O ... X
+        Try both states on each unknown cell and propagate them with the rules of the search (see probing.c).
+        If a state leads to a conflict, or a black cell would split the white cells, the cell takes the other state.
+        The cells taking the same state in both propagations are marked too. The probes are independent, so each thread
+        probes its share of the cells on its own block, then the marked cells are applied and the probing is repeated until nothing changes.
+
+        e.g. A corner cell with a black neighbour on its right: a black cell below it would isolate the corner, so it is marked white
     */
 
-    int i, j, k;
+    int i, cells_count = board.rows_count * board.cols_count, max_threads = omp_get_max_threads(), fixed_count = 1;
+    bool consistent = true;
 
-    int *set_white_solution = (int *) malloc(board.rows_count * board.cols_count * sizeof(int));    
-    memset(set_white_solution, UNKNOWN, board.rows_count * board.cols_count * sizeof(int));
+    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(cells_count * sizeof(int)), board.occurrences };
+    memcpy(solution.solution, board.solution, cells_count * sizeof(int));
 
-    for (i = 0; i < board.rows_count; i++) {
-        for (j = 0; j < board.cols_count; j++) {
-            if (board.solution[i * board.cols_count + j] == WHITE) {
-                int value = board.grid[i * board.cols_count + j];
-                
-                for (k = 0; k < board.cols_count; k++) {
-                    if (board.grid[i * board.cols_count + k] == value && k != j) {
-                        set_white_solution[i * board.cols_count + k] = BLACK;
+    BCB board_block;
+    init_probe_block(solution, &board_block);
 
-                        if (k - 1 >= 0) set_white_solution[i * board.cols_count + k - 1] = WHITE;
-                        if (k + 1 < board.cols_count) set_white_solution[i * board.cols_count + k + 1] = WHITE;
-                    }
-                }
+    // Each thread marks the cells on its own flags, they are merged after the probes
+    int *forced_flags = (int *) malloc(max_threads * cells_count * sizeof(int));
 
-                for (k = 0; k < board.rows_count; k++) {
-                    if (board.grid[k * board.rows_count + j] == value && k != i) {
-                        set_white_solution[k * board.rows_count + j] = BLACK;
+    while (consistent && fixed_count > 0) {
+        memset(forced_flags, 0, max_threads * cells_count * sizeof(int));
 
-                        if (k - 1 >= 0) set_white_solution[(k - 1) * board.rows_count + j] = WHITE;
-                        if (k + 1 < board.rows_count) set_white_solution[(k + 1) * board.rows_count + j] = WHITE;
-                    }
+        #pragma omp parallel
+        {
+            int *thread_flags = forced_flags + omp_get_thread_num() * cells_count;
+            int *probe_trail = (int *) malloc(cells_count * sizeof(int));
+            BCB block;
+            init_probe_block(solution, &block);
+
+            int cell_index;
+            #pragma omp for schedule(dynamic, 8)
+            for (cell_index = 0; cell_index < cells_count; cell_index++) {
+                if (block.solution[cell_index] != UNKNOWN || thread_flags[cell_index] != 0) continue;
+                if (!probe_cell(solution, &block, cell_index, probe_trail, thread_flags)) {
+                    #pragma omp atomic write
+                    consistent = false;
                 }
             }
-        }
-    }
-
-    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)) };
-    memcpy(solution.solution, set_white_solution, board.rows_count * board.cols_count * sizeof(int));
-
-    return solution;
-}
-
-Board set_black(Board board) {
-    
-    /*
-        RULE DESCRIPTION:
-        
-        When you have marked a black cell, all the cells around it must be white.
 
-        e.g. 2 X 2 --> O X O
-    */
+            free_block(&block);
+            free(probe_trail);
+        }
 
-    int i, j;
+        for (i = cells_count; i < max_threads * cells_count; i++)
+            forced_flags[i % cells_count] |= forced_flags[i];
 
-    int *set_black_solution = (int *) malloc(board.rows_count * board.cols_count * sizeof(int));
-    memset(set_black_solution, UNKNOWN, board.rows_count * board.cols_count * sizeof(int));
+        if (consistent)
+            consistent = apply_forced_flags(solution, &board_block, forced_flags, &fixed_count);
+        memcpy(solution.solution, board_block.solution, cells_count * sizeof(int));
+    }
 
-    for (i = 0; i < board.rows_count; i++) {
-        for (j = 0; j < board.cols_count; j++) {
-            if (board.solution[i * board.cols_count + j] == BLACK) {
-                if (j - 1 >= 0) set_black_solution[i * board.cols_count + j - 1] = WHITE;
-                if (j + 1 < board.cols_count) set_black_solution[i * board.cols_count + j + 1] = WHITE;
-                
-                if (i - 1 >= 0) set_black_solution[(i - 1) * board.rows_count + j ] = WHITE;
-                if (i + 1 < board.rows_count) set_black_solution[(i + 1) * board.rows_count + j ] = WHITE;
-            }
-        }
+    if (!consistent) {
+        printf("[ERROR] The board has no solution, every state of a cell leads to a conflict\n");
+        exit(-1);
     }
 
-    Board solution = { board.grid, board.rows_count, board.cols_count, (int *) malloc(board.rows_count * board.cols_count * sizeof(int)) };
-    memcpy(solution.solution, set_black_solution, board.rows_count * board.cols_count * sizeof(int));
+    free_block(&board_block);
+    free(forced_flags);
 
     return solution;
 }
@@ -0,0 +1,431 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/row_patterns.h"
+
+bool build_row_patterns(Board board, RowPatterns *patterns) {
+
+    /*
+        This function is responsible for building the legal black masks of each row of the board, once, before the search.
+        A mask is legal when it has no adjacent black cells, no duplicated values among its white cells, and agrees with the cells
+        already set by the pruning. The masks are then filtered with the constraints between the rows, see filter_row_patterns.
+        It returns false when the board has more than 32 columns or a row has more than MAX_ROW_PATTERNS masks, in which case
+        the row patterns engine cannot be used.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved, with the cells set by the pruning
+            patterns: the row patterns to build
+    */
+
+    if (board.cols_count > ROW_PATTERNS_MAX_COLS) return false;
+
+    int i, j, row, col, capacity = board.rows_count * 16;
+    int max_value = board.rows_count > board.cols_count ? board.rows_count : board.cols_count;
+
+    patterns->masks = (uint32_t *) malloc(capacity * sizeof(uint32_t));
+    patterns->offsets = (int *) malloc(board.rows_count * sizeof(int));
+    patterns->counts = (int *) malloc(board.rows_count * sizeof(int));
+    patterns->same_values = (uint32_t *) calloc(board.rows_count * board.rows_count, sizeof(uint32_t));
+    bool *white_values = (bool *) calloc(max_value + 1, sizeof(bool));
+
+    for (row = 0; row < board.rows_count; row++) {
+        patterns->offsets[row] = row == 0 ? 0 : patterns->offsets[row - 1] + patterns->counts[row - 1];
+        patterns->counts[row] = 0;
+        if (!enumerate_row_masks(board, patterns, row, 0, 0, white_values, &capacity)) {
+            free(white_values);
+            free_row_patterns(patterns);
+            return false;
+        }
+    }
+    free(white_values);
+
+    for (i = 0; i < board.rows_count; i++)
+        for (j = 0; j < board.rows_count; j++)
+            for (col = 0; col < board.cols_count && i != j; col++)
+                if (board.grid[i * board.cols_count + col] == board.grid[j * board.cols_count + col])
+                    patterns->same_values[i * board.rows_count + j] |= 1u << col;
+
+    filter_row_patterns(board, patterns);
+    return true;
+}
+
+bool enumerate_row_masks(Board board, RowPatterns *patterns, int row, int col, uint32_t mask, bool *white_values, int *capacity) {
+
+    /*
+        This function is responsible for enumerating the legal masks of a row, deciding its cells from the given column onwards.
+        A cell can be white when its value is not already white in the row, and black when the cell on its left is not black.
+        The masks are appended after the ones of the row already found, growing the masks vector when needed.
+        It returns false when the row has more than MAX_ROW_PATTERNS masks.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            patterns: the row patterns being built
+            row: the row to enumerate
+            col: the next column to decide
+            mask: the black cells of the columns already decided
+            white_values: flags of the values already white in the columns decided
+            capacity: the size of the masks vector
+    */
+
+    if (col == board.cols_count) {
+        if (patterns->counts[row] == MAX_ROW_PATTERNS) return false;
+
+        int mask_index = patterns->offsets[row] + patterns->counts[row]++;
+        if (mask_index == *capacity) {
+            *capacity *= 2;
+            patterns->masks = (uint32_t *) realloc(patterns->masks, *capacity * sizeof(uint32_t));
+        }
+        patterns->masks[mask_index] = mask;
+        return true;
+    }
+
+    int cell_value = board.grid[row * board.cols_count + col];
+    CellState cell_state = board.solution[row * board.cols_count + col];
+
+    if (cell_state != BLACK && !white_values[cell_value]) {
+        white_values[cell_value] = true;
+        bool completed = enumerate_row_masks(board, patterns, row, col + 1, mask, white_values, capacity);
+        white_values[cell_value] = false;
+        if (!completed) return false;
+    }
+
+    if (cell_state != WHITE && (col == 0 || !(mask & (1u << (col - 1)))))
+        return enumerate_row_masks(board, patterns, row, col + 1, mask | (1u << col), white_values, capacity);
+
+    return true;
+}
+
+void filter_row_patterns(Board board, RowPatterns *patterns) {
+
+    /*
+        This function is responsible for making the masks of the rows arc consistent: a mask is removed when another row constrained
+        with it, being adjacent or having a same-value column, has no mask compatible with it. The removals are repeated until none happens.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            patterns: the row patterns to filter
+    */
+
+    int i, row, other_row, kept;
+    uint32_t mask;
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+        for (row = 0; row < board.rows_count; row++) {
+            for (other_row = 0; other_row < board.rows_count; other_row++) {
+                if (other_row == row) continue;
+                if (abs(other_row - row) != 1 && patterns->same_values[row * board.rows_count + other_row] == 0) continue;
+
+                kept = 0;
+                for (i = 0; i < patterns->counts[row]; i++) {
+                    mask = patterns->masks[patterns->offsets[row] + i];
+                    if (has_row_support(board, patterns, mask, row, other_row))
+                        patterns->masks[patterns->offsets[row] + kept++] = mask;
+                }
+
+                if (kept < patterns->counts[row]) {
+                    patterns->counts[row] = kept;
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+bool has_row_support(Board board, RowPatterns *patterns, uint32_t mask, int row, int other_row) {
+
+    /*
+        This function is responsible for checking if the other row has a mask compatible with the given mask of the row.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            patterns: the row patterns
+            mask: the mask of the row
+            row: the row of the mask
+            other_row: the row in which the compatible mask is searched
+    */
+
+    int i;
+    uint32_t same = patterns->same_values[row * board.rows_count + other_row];
+    bool adjacent = abs(other_row - row) == 1;
+
+    for (i = 0; i < patterns->counts[other_row]; i++)
+        if (ROWS_COMPATIBLE(mask, patterns->masks[patterns->offsets[other_row] + i], same, adjacent))
+            return true;
+    return false;
+}
+
+void free_row_patterns(RowPatterns *patterns) {
+
+    /*
+        This function is responsible for freeing the memory of the row patterns.
+    */
+
+    /*
+        Parameters:
+            patterns: the row patterns to free
+    */
+
+    free(patterns->masks);
+    free(patterns->offsets);
+    free(patterns->counts);
+    free(patterns->same_values);
+}
+
+void init_row_search(Board board, RowPatterns *patterns, RowSearch *search, int first_mask, int stride) {
+
+    /*
+        This function is responsible for initializing a search over the row patterns, with its own copy of the masks
+        since the search reorders them while filtering the domains of the rows.
+        The search tries the masks of the first row starting from first_mask and moving by stride, so that
+        the workers sharing the board can split the first row among them.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            patterns: the row patterns
+            search: the search to initialize
+            first_mask: the index of the first mask of the first row tried by the search
+            stride: the step between the masks of the first row tried by the search
+    */
+
+    int masks_count = patterns->offsets[board.rows_count - 1] + patterns->counts[board.rows_count - 1];
+
+    search->masks = (uint32_t *) malloc(masks_count * sizeof(uint32_t));
+    search->domain_counts = (int *) malloc(board.rows_count * board.rows_count * sizeof(int));
+    search->choices = (int *) malloc(board.rows_count * sizeof(int));
+    search->white_rows = (uint32_t *) malloc(board.rows_count * sizeof(uint32_t));
+    search->reached_rows = (uint32_t *) malloc(board.rows_count * sizeof(uint32_t));
+
+    memcpy(search->masks, patterns->masks, masks_count * sizeof(uint32_t));
+    memcpy(search->domain_counts, patterns->counts, board.rows_count * sizeof(int));
+    search->depth = 0;
+    search->first_row_stride = stride;
+    search->choices[0] = first_mask - stride;
+    search->nodes = 0;
+}
+
+void free_row_search(RowSearch *search) {
+
+    /*
+        This function is responsible for freeing the memory of a search over the row patterns.
+    */
+
+    /*
+        Parameters:
+            search: the search to free
+    */
+
+    free(search->masks);
+    free(search->domain_counts);
+    free(search->choices);
+    free(search->white_rows);
+    free(search->reached_rows);
+}
+
+RowSearchResult search_row_patterns(Board board, RowPatterns *patterns, RowSearch *search, long long max_nodes) {
+
+    /*
+        This function is responsible for searching the solution one row at a time: each row takes the next mask of its domain,
+        made of the masks compatible with the rows above, as long as the white cells can still be connected and the rows below
+        keep at least one mask, see filter_row_domains. When a row has no masks left, the search goes back to the row above.
+        The search stops after max_nodes masks have been tried, so that the caller can check for termination, and resumes from
+        the same point when called again. After a solution, it resumes from the next mask of the last row.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            patterns: the row patterns
+            search: the state of the search, updated
+            max_nodes: the maximum number of masks tried before pausing the search
+    */
+
+    int row;
+    uint32_t mask;
+    long long nodes_limit = search->nodes + max_nodes;
+
+    if (search->depth == board.rows_count) search->depth--;
+
+    while (search->depth >= 0) {
+        if (search->nodes >= nodes_limit) return ROW_SEARCH_PAUSED;
+
+        row = search->depth;
+        search->choices[row] += row == 0 ? search->first_row_stride : 1;
+        if (search->choices[row] >= search->domain_counts[row * board.rows_count + row]) {
+            search->depth--;
+            continue;
+        }
+
+        mask = search->masks[patterns->offsets[row] + search->choices[row]];
+        search->nodes++;
+
+        search->white_rows[row] = ~mask & ROW_FULL_MASK(board.cols_count);
+        if (!are_row_whites_connected(board, search, row)) continue;
+
+        if (row == board.rows_count - 1) {
+            search->depth++;
+            return ROW_SEARCH_FOUND;
+        }
+        if (!filter_row_domains(board, patterns, search, row, mask)) continue;
+
+        search->depth++;
+        search->choices[search->depth] = -1;
+    }
+    return ROW_SEARCH_EXHAUSTED;
+}
+
+bool filter_row_domains(Board board, RowPatterns *patterns, RowSearch *search, int row, uint32_t mask) {
+
+    /*
+        This function is responsible for computing the domains of the rows below the given one, once its mask is chosen:
+        the masks of a row constrained with it, being adjacent or having a same-value column, are kept only if compatible with the mask.
+        The incompatible masks are swapped after the ones kept, so the domain of each depth is a prefix of the previous one
+        and going back to a row only needs its counts, stored as domain_counts[depth * rows_count + row].
+        It returns false if a row is left without masks.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            patterns: the row patterns
+            search: the state of the search, updated
+            row: the row whose mask has been chosen
+            mask: the chosen mask
+    */
+
+    int i, other_row, count;
+    uint32_t same, other_mask, *masks;
+    bool adjacent;
+
+    for (other_row = row + 1; other_row < board.rows_count; other_row++) {
+        count = search->domain_counts[row * board.rows_count + other_row];
+        same = patterns->same_values[row * board.rows_count + other_row];
+        adjacent = other_row == row + 1;
+
+        if (same != 0 || adjacent) {
+            masks = search->masks + patterns->offsets[other_row];
+            i = 0;
+            while (i < count) {
+                other_mask = masks[i];
+                if (ROWS_COMPATIBLE(mask, other_mask, same, adjacent))
+                    i++;
+                else {
+                    masks[i] = masks[count - 1];
+                    masks[count - 1] = other_mask;
+                    count--;
+                }
+            }
+            if (count == 0) return false;
+        }
+
+        search->domain_counts[(row + 1) * board.rows_count + other_row] = count;
+    }
+    return true;
+}
+
+bool are_row_whites_connected(Board board, RowSearch *search, int last_row) {
+
+    /*
+        This function is responsible for checking the connectivity of the white cells of the rows chosen so far.
+        Before the last row of the board, every group of white cells must reach the last chosen row, otherwise it is closed
+        and can never be connected to the white cells of the rows below. On the last row, all the white cells must be connected.
+        The white cells are reached with bit-parallel sweeps up and down the rows, until nothing changes.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            search: the state of the search
+            last_row: the last row with a chosen mask
+    */
+
+    int row;
+    uint32_t reached, neighbours;
+    uint32_t *white_rows = search->white_rows, *reached_rows = search->reached_rows;
+    bool changed = true;
+
+    memset(reached_rows, 0, (last_row + 1) * sizeof(uint32_t));
+    if (last_row < board.rows_count - 1)
+        reached_rows[last_row] = white_rows[last_row];
+    else {
+        for (row = 0; row <= last_row && white_rows[row] == 0; row++);
+        if (row > last_row) return true;
+        reached_rows[row] = expand_row_whites(white_rows[row] & -white_rows[row], white_rows[row]);
+    }
+
+    while (changed) {
+        changed = false;
+        for (row = last_row; row >= 0; row--) {
+            neighbours = (row > 0 ? reached_rows[row - 1] : 0) | (row < last_row ? reached_rows[row + 1] : 0);
+            reached = expand_row_whites(reached_rows[row] | (neighbours & white_rows[row]), white_rows[row]);
+            if (reached != reached_rows[row]) {
+                reached_rows[row] = reached;
+                changed = true;
+            }
+        }
+        for (row = 0; row <= last_row; row++) {
+            neighbours = (row > 0 ? reached_rows[row - 1] : 0) | (row < last_row ? reached_rows[row + 1] : 0);
+            reached = expand_row_whites(reached_rows[row] | (neighbours & white_rows[row]), white_rows[row]);
+            if (reached != reached_rows[row]) {
+                reached_rows[row] = reached;
+                changed = true;
+            }
+        }
+    }
+
+    for (row = 0; row <= last_row; row++)
+        if (reached_rows[row] != white_rows[row])
+            return false;
+    return true;
+}
+
+uint32_t expand_row_whites(uint32_t seed, uint32_t whites) {
+
+    /*
+        This function is responsible for expanding the seed cells of a row to the runs of white cells containing them.
+    */
+
+    /*
+        Parameters:
+            seed: the reached cells of the row
+            whites: the white cells of the row
+    */
+
+    uint32_t reached = seed & whites, previous = 0;
+    while (reached != previous) {
+        previous = reached;
+        reached |= ((reached << 1) | (reached >> 1)) & whites;
+    }
+    return reached;
+}
+
+void row_search_to_solution(Board board, RowSearch *search, CellState *solution) {
+
+    /*
+        This function is responsible for writing the rows chosen by the search into the solution matrix.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            search: the search that found the solution
+            solution: the solution matrix to fill
+    */
+
+    int i, j;
+    for (i = 0; i < board.rows_count; i++)
+        for (j = 0; j < board.cols_count; j++)
+            solution[i * board.cols_count + j] = (search->white_rows[i] >> j) & 1u ? WHITE : BLACK;
+}
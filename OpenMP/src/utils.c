@@ -114,3 +114,64 @@ void free_memory(int *pointers[]) {
         free(pointers[i]);
     }
 }
+
+SolverConfig read_config(int argc, char **argv) {
+
+    /*
+        Helper function to read the solver configuration from the optional command line arguments, given after the input file as --key=value.
+        The options not provided keep their default value.
+    */
+
+    /*
+        Parameters:
+            - argc: the number of command line arguments
+            - argv: the command line arguments
+    */
+
+    SolverConfig config = {
+        .engine = BACKTRACKING,
+        .branching = STATIC_ORDER,
+        .value_order = WHITE_FIRST,
+        .restarts = false,
+        .seed = 1,
+        .learning = true
+    };
+
+    int i;
+    for (i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--engine=backtracking") == 0)
+            config.engine = BACKTRACKING;
+        else if (strcmp(argv[i], "--engine=rows") == 0)
+            config.engine = ROW_PATTERNS;
+        else if (strcmp(argv[i], "--engine=cdcl") == 0)
+            config.engine = CDCL;
+        else if (strcmp(argv[i], "--engine=frontier") == 0)
+            config.engine = FRONTIER;
+        else if (strcmp(argv[i], "--branching=static") == 0)
+            config.branching = STATIC_ORDER;
+        else if (strcmp(argv[i], "--branching=most-constrained") == 0)
+            config.branching = MOST_CONSTRAINED;
+        else if (strcmp(argv[i], "--branching=groups") == 0)
+            config.branching = DUPLICATE_GROUPS;
+        else if (strcmp(argv[i], "--value-order=white-first") == 0)
+            config.value_order = WHITE_FIRST;
+        else if (strcmp(argv[i], "--value-order=pressure") == 0)
+            config.value_order = CONFLICT_PRESSURE;
+        else if (strcmp(argv[i], "--restarts=on") == 0)
+            config.restarts = true;
+        else if (strcmp(argv[i], "--restarts=off") == 0)
+            config.restarts = false;
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            config.seed = (unsigned int) strtoul(argv[i] + 7, NULL, 10);
+        else if (strcmp(argv[i], "--learning=on") == 0)
+            config.learning = true;
+        else if (strcmp(argv[i], "--learning=off") == 0)
+            config.learning = false;
+        else {
+            printf("[ERROR] Unknown option %s\n", argv[i]);
+            exit(-1);
+        }
+    }
+
+    return config;
+}
@@ -3,6 +3,8 @@
 #include <stdio.h>
 
 #include "../include/validation.h"
+#include "../include/bitboard.h"
+#include "../include/black_chains.h"
 
 bool is_cell_state_valid(Board board, BCB* block, int x, int y, CellState cell_state) {
 
@@ -10,36 +12,77 @@ bool is_cell_state_valid(Board board, BCB* block, int x, int y, CellState cell_s
     // Rule 2: Shaded cells cannot be adjacent, although they can touch at a corner
 
     if (cell_state == BLACK) {
-        if (x > 0 && block->solution[(x - 1) * board.cols_count + y] == BLACK) return false;
-        if (x < board.rows_count - 1 && block->solution[(x + 1) * board.cols_count + y] == BLACK) return false;
-        if (y > 0 && block->solution[x * board.cols_count + y - 1] == BLACK) return false;
-        if (y < board.cols_count - 1 && block->solution[x * board.cols_count + y + 1] == BLACK) return false;
+        // Test the neighbours on the black bit rows, the bits outside the board are never set
+        int words_per_row = WORDS_PER_ROW(board.cols_count);
+        int word = y / BITS_PER_WORD, offset = y % BITS_PER_WORD;
+        uint64_t cell_bit = 1ULL << offset;
+        uint64_t *black_row = block->black_rows + x * words_per_row;
+
+        if (black_row[word] & ((cell_bit << 1) | (cell_bit >> 1))) return false;
+        if (offset == 0 && word > 0 && (black_row[word - 1] >> (BITS_PER_WORD - 1))) return false;
+        if (offset == BITS_PER_WORD - 1 && word < words_per_row - 1 && (black_row[word + 1] & 1ULL)) return false;
+        if (x > 0 && (black_row[word - words_per_row] & cell_bit)) return false;
+        if (x < board.rows_count - 1 && (black_row[word + words_per_row] & cell_bit)) return false;
+
+        // Rule 3: a black cell closing a chain of diagonal black cells would split the white cells
+        if (closes_black_chain(board, &block->chains, block->solution, x, y)) return false;
     } else if (cell_state == WHITE) {
-        int i, j, cell_value = board.grid[x * board.cols_count + y];
-        for (i = 0; i < board.rows_count; i++)
-            if (i != x && board.grid[i * board.cols_count + y] == cell_value && block->solution[i * board.cols_count + y] == WHITE)
-                return false;
-        for (j = 0; j < board.cols_count; j++)
-            if (j != y && board.grid[x * board.cols_count + j] == cell_value && block->solution[x * board.cols_count + j] == WHITE)
-                return false;
+        // The white counters already include the cell itself when it is white, so it must be discounted
+        int cell_value = board.grid[x * board.cols_count + y];
+        int self_count = block->solution[x * board.cols_count + y] == WHITE ? 1 : 0;
+        if (block->row_white_counts[x * (board.cols_count + 1) + cell_value] - self_count > 0) return false;
+        if (block->col_white_counts[y * (board.rows_count + 1) + cell_value] - self_count > 0) return false;
     }
     return true;
 }
 
-int dfs_white_cells(Board board, BCB *block, bool* visited, int row, int col) {
-    if (row < 0 || row >= board.rows_count || col < 0 || col >= board.cols_count) return 0;
-    if (visited[row * board.cols_count + col]) return 0;
-    if (block->solution[row * board.cols_count + col] == BLACK) return 0;
+int expand_reached_row(Board board, BCB *block, uint64_t *reached, int words_per_row, int row) {
+
+    /*
+        This function is responsible for expanding the reached white cells of a row: the row is seeded with the reached cells of the rows above and below,
+        then it is grown horizontally with shifts until it stops changing. Only white cells can be reached.
+        It returns the number of cells newly reached in the row.
+    */
+
+    /*
+        Parameters:
+            board: the board to be solved
+            block: the BCB to analyze
+            reached: the bit rows of the reached white cells
+            words_per_row: the number of words of each bit row
+            row: the index of the row to expand
+    */
 
-    visited[row * board.cols_count + col] = true;
+    uint64_t *reached_row = reached + row * words_per_row;
+    uint64_t *white_row = block->white_rows + row * words_per_row;
+    int i, new_cells = 0;
+
+    for (i = 0; i < words_per_row; i++) {
+        uint64_t vertical = 0;
+        if (row > 0) vertical |= reached_row[i - words_per_row];
+        if (row < board.rows_count - 1) vertical |= reached_row[i + words_per_row];
+        uint64_t grown = (reached_row[i] | vertical) & white_row[i];
+        new_cells += __builtin_popcountll(grown ^ reached_row[i]);
+        reached_row[i] = grown;
+    }
 
-    int count = 1;
-    // Count all the connected white cells in all directions
-    count += dfs_white_cells(board, block, visited, row - 1, col);
-    count += dfs_white_cells(board, block, visited, row + 1, col);
-    count += dfs_white_cells(board, block, visited, row, col - 1);
-    count += dfs_white_cells(board, block, visited, row, col + 1);
-    return count;
+    // Grow the row horizontally, carrying the bits across the words, until a fixed point is reached
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (i = 0; i < words_per_row; i++) {
+            uint64_t grown = reached_row[i] | (reached_row[i] << 1) | (reached_row[i] >> 1);
+            if (i > 0) grown |= reached_row[i - 1] >> (BITS_PER_WORD - 1);
+            if (i < words_per_row - 1) grown |= reached_row[i + 1] << (BITS_PER_WORD - 1);
+            grown &= white_row[i];
+            if (grown != reached_row[i]) {
+                new_cells += __builtin_popcountll(grown ^ reached_row[i]);
+                reached_row[i] = grown;
+                changed = true;
+            }
+        }
+    }
+    return new_cells;
 }
 
 bool check_hitori_conditions(Board board, BCB* block) {
@@ -51,32 +94,35 @@ bool check_hitori_conditions(Board board, BCB* block) {
             Rule 3: When completed, all un-shaded (white) squares create a single continuous area
 
         The first two rules are already checked by the is_cell_state_valid function.
-        The third rule is checked by the bfs_white_cells function.
+        The third rule is checked with a flood fill on the white bit rows: starting from the first white cell,
+        the reached cells are expanded row by row, sweeping down and up the board, until they stop changing.
+        The fill stops as soon as every white cell has been reached.
     */
 
-    int board_size = board.rows_count * board.cols_count;
-    bool visited[board_size];
-    memset(visited, false, board_size * sizeof(bool));
+    int words_per_row = WORDS_PER_ROW(board.cols_count);
+    int words_count = board.rows_count * words_per_row;
 
     // Count all the white cells, and find the first white cell
-    int i, j;
-    int row = -1, col = -1;
-    int white_cells_count = 0;
-    for (i = 0; i < board.rows_count; i++) {
-        for (j = 0; j < board.cols_count; j++) {
-            if (block->solution[i * board.cols_count + j] == WHITE) {
-                // Count white cells
-                white_cells_count++;
-
-                // Find the first white cell
-                if (row == -1 && col == -1) {
-                    row = i;
-                    col = j;
-                }
-            }
-        }
-    }
+    int white_cells_count = count_bits(block->white_rows, words_count);
+    int first_white = find_first_bit(block->white_rows, words_count);
+    if (first_white == -1) return true;
+
+    uint64_t reached[words_count];
+    memset(reached, 0, words_count * sizeof(uint64_t));
+    reached[first_white / BITS_PER_WORD] = 1ULL << (first_white % BITS_PER_WORD);
+
+    int row, new_cells, reached_count = 1;
+    do {
+        new_cells = 0;
+        for (row = first_white / (words_per_row * BITS_PER_WORD); row < board.rows_count; row++)
+            new_cells += expand_reached_row(board, block, reached, words_per_row, row);
+        for (row = board.rows_count - 2; row >= 0; row--)
+            new_cells += expand_reached_row(board, block, reached, words_per_row, row);
+
+        // Check if the number of reached cells is equal to the number of white cells (meaning a single continuous area)
+        reached_count += new_cells;
+        if (reached_count == white_cells_count) return true;
+    } while (new_cells > 0);
 
-    // Check if the number of white cells is equal to the number of connected white cells (meaning a single continuous area)
-    return dfs_white_cells(board, block, visited, row, col) == white_cells_count;
+    return false;
 }